@@ -1,355 +1,565 @@
-/*
- * Chiffres.h
- *
- * Created on 25/12/2020
- * Author Totof
- * Matrices de chiffres et caractères pour affichage sur une matrice de LED 8*8
+/*!
+ *   \file    Chiffres.h
+ *   \brief   Liste des caractères pour affichage sur les matrices
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    25/12/2020
  *
+ *   \details Généré par polices/compilateur depuis polices/chiffres.txt, ne pas modifier :
+ *            changer la police puis make -C polices
  */
  
 #ifndef Chiffres_h
 #define Chiffres_h
 
-// ****************
-// Chiffre de 0 à 9
-// ****************
-
-uint8_t zero []  = {
-	0b00111000,
-	0b01000100,
-	0b01000100,
-	0b01000100,
-	0b01000100,
-	0b01000100,
-	0b01000100,
-	0b00111000
-};
-
-uint8_t un [] = {
-	0b00010000,
-	0b00110000,
-	0b01010000,
-	0b00010000,
-	0b00010000,
-	0b00010000,
-	0b00010000,
-	0b01111100
-};
-
-uint8_t deux [] = {
-	0b00111000,
-	0b01000100,
-	0b00000100,
-	0b00001000,
-	0b00010000,
-	0b00100000,
-	0b01000000,
-	0b01111100
-};
-
-uint8_t trois [] = {
-	0b00111000,
-	0b01000100,
-	0b00000100,
-	0b00011000,
-	0b00011000,
-	0b00000100,
-	0b01000100,
-	0b00111000
-};
-
-uint8_t quatre [] = {
-	0b00000100,
-	0b00001000,
-	0b00010000,
-	0b00100000,
-	0b01001000,
-	0b01111100,
-	0b00001000,
-	0b00001000
-};
-
-uint8_t cinq [] = {
-	0b01111100,
-	0b01000000,
-	0b01000000,
-	0b01111000,
-	0b00000100,
-	0b00000100,
-	0b01000100,
-	0b00111000
-};
-
-uint8_t six [] = {
-	0b00111000,
-	0b01000100,
-	0b01000000,
-	0b01111000,
-	0b01000100,
-	0b01000100,
-	0b01000100,
-	0b00111000
-};
-
-uint8_t sept [] = {
-	0b01111100,
-	0b00000100,
-	0b00000100,
-	0b00001000,
-	0b00010000,
-	0b00100000,
-	0b01000000,
-	0b01000000
-};
-
-uint8_t huit [] = {
-	0b00111000,
-	0b01000100,
-	0b01000100,
-	0b00111000,
-	0b01000100,
-	0b01000100,
-	0b01000100,
-	0b00111000
-};
-
-uint8_t neuf [] = {
-	0b00111000,
-	0b01000100,
-	0b01000100,
-	0b00111100,
-	0b00000100,
-	0b00000100,
-	0b01000100,
-	0b00111000
-};
-
-// ****************************************
-// Chiffre de 0 à 9 avec décalage d'un rang
-// ****************************************
-uint8_t zeroDm []  = {
-	0b00011100,
-	0b00100010,
-	0b00100010,
-	0b00100010,
-	0b00100010,
-	0b00100010,
-	0b00100010,
-	0b00011100
-};
-
-uint8_t unDm [] = {
-	0b00001000,
-	0b00011000,
-	0b00101000,
-	0b00001000,
-	0b00001000,
-	0b00001000,
-	0b00001000,
-	0b00111110
-};
-
-uint8_t deuxDm [] = {
-	0b00011100,
-	0b00100010,
-	0b00000010,
-	0b00000100,
-	0b00001000,
-	0b00010000,
-	0b00100000,
-	0b00111110
-};
-
-uint8_t troisDm [] = {
-	0b00011100,
-	0b00100010,
-	0b00000010,
-	0b00001100,
-	0b00001100,
-	0b00000010,
-	0b00100010,
-	0b00011100
-};
-
-uint8_t quatreDm [] = {
-	0b00000010,
-	0b00000100,
-	0b00001000,
-	0b00010000,
-	0b00100100,
-	0b00111110,
-	0b00000100,
-	0b00000100
-};
-
-uint8_t cinqDm [] = {
-	0b00111110,
-	0b00100000,
-	0b00100000,
-	0b00111100,
-	0b00000010,
-	0b00000010,
-	0b00100010,
-	0b00011100
-};
-
-uint8_t sixDm [] = {
-	0b00011100,
-	0b00100010,
-	0b00100000,
-	0b00111100,
-	0b00100010,
-	0b00100010,
-	0b00100010,
-	0b00011100
-};
-
-uint8_t septDm [] = {
-	0b00111110,
-	0b00000010,
-	0b00000010,
-	0b00000100,
-	0b00001000,
-	0b00010000,
-	0b00100000,
-	0b00100000
-};
-
-uint8_t huitDm [] = {
-	0b00011100,
-	0b00100010,
-	0b00100010,
-	0b00011100,
-	0b00100010,
-	0b00100010,
-	0b00100010,
-	0b00011100
-};
-
-uint8_t neufDm [] = {
-	0b00011100,
-	0b00100010,
-	0b00100010,
-	0b00011110,
-	0b00000010,
-	0b00000010,
-	0b00100010,
-	0b00011100
-};
-
-// *********************************
-// Chiffre de 0 à 9 avec deux points
-// *********************************
-
-uint8_t zeroDp [] = {
-	0b01110000,
-	0b10001000,
-	0b10001000,
-	0b10001001,
-	0b10001000,
-	0b10001000,
-	0b10001001,
-	0b01110000
-};
-
-uint8_t unDp [] = {
-	0b00100000,
-	0b01100000,
-	0b10100000,
-	0b00100001,
-	0b00100000,
-	0b00100000,
-	0b00100001,
-	0b11111000
-};
-
-uint8_t deuxDp [] = {
-	0b01110000,
-	0b10001000,
-	0b00001000,
-	0b00010001,
-	0b00100000,
-	0b01000000,
-	0b10000001,
-	0b11111000
-};
-
-uint8_t troisDp [] = {
-	0b01110000,
-	0b10001000,
-	0b00001000,
-	0b00110001,
-	0b00110000,
-	0b00001000,
-	0b10001001,
-	0b01110000
-};
-
-uint8_t quatreDp [] = {
-	0b00001000,
-	0b00010000,
-	0b00100000,
-	0b01000001,
-	0b10010000,
-	0b11111000,
-	0b00010001,
-	0b00010000
-};
-
-uint8_t cinqDp [] = {
-	0b11111000,
-	0b10000000,
-	0b10000000,
-	0b11110001,
-	0b00001000,
-	0b00001000,
-	0b10001001,
-	0b01110000
-};
-
-uint8_t sixDp [] = {
-	0b01110000,
-	0b10001000,
-	0b10000000,
-	0b11110001,
-	0b10001000,
-	0b10001000,
-	0b10001001,
-	0b01110000
-};
-
-uint8_t septDp [] = {
-	0b11111000,
-	0b00001000,
-	0b00001000,
-	0b00010001,
-	0b00100000,
-	0b01000000,
-	0b10000001,
-	0b10000000
-};
-
-uint8_t huitDp [] = {
-	0b01110000,
-	0b10001000,
-	0b10001000,
-	0b01110001,
-	0b10001000,
-	0b10001000,
-	0b10001001,
-	0b01110000
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+/**
+ *   \brief   Variantes des chiffres, premier indice de la table chiffres
+ */ 
+#define VARIANTE_NORMALE     0
+#define VARIANTE_VIRGULE     1
+#define VARIANTE_DECALEE     2
+#define VARIANTE_DEUX_POINTS 3
+#define NB_VARIANTES         4
+
+/**
+ *   \brief   Nombre de chiffres par variante
+ */ 
+#define NB_CHIFFRES 10
+
+/**
+ *   \brief   Codes des symboles, à la suite des chiffres
+ *
+ *   \details CAR_VIDE n'a pas de dessin et donne une matrice éteinte
+ */ 
+#define CAR_DEGRE    10
+#define CAR_POURCENT 11
+#define CAR_MOINS    12
+#define NB_SYMBOLES  3
+#define CAR_VIDE     (NB_CHIFFRES + NB_SYMBOLES)
+
+/**
+ *   \brief   Chiffres de 0 à 9 dans toutes leurs variantes, en flash
+ *
+ *   \details Indices : [variante][chiffre][ligne]
+ */ 
+const uint8_t chiffres[NB_VARIANTES][NB_CHIFFRES][8] PROGMEM = {
+	// Variante NORMALE
+	{
+		// 0
+		{
+			0b00111000,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b00111000
+		},
+		// 1
+		{
+			0b00010000,
+			0b00110000,
+			0b01010000,
+			0b00010000,
+			0b00010000,
+			0b00010000,
+			0b00010000,
+			0b01111100
+		},
+		// 2
+		{
+			0b00111000,
+			0b01000100,
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b01000000,
+			0b01111100
+		},
+		// 3
+		{
+			0b00111000,
+			0b01000100,
+			0b00000100,
+			0b00011000,
+			0b00011000,
+			0b00000100,
+			0b01000100,
+			0b00111000
+		},
+		// 4
+		{
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b01001000,
+			0b01111100,
+			0b00001000,
+			0b00001000
+		},
+		// 5
+		{
+			0b01111100,
+			0b01000000,
+			0b01000000,
+			0b01111000,
+			0b00000100,
+			0b00000100,
+			0b01000100,
+			0b00111000
+		},
+		// 6
+		{
+			0b00111000,
+			0b01000100,
+			0b01000000,
+			0b01111000,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b00111000
+		},
+		// 7
+		{
+			0b01111100,
+			0b00000100,
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b01000000,
+			0b01000000
+		},
+		// 8
+		{
+			0b00111000,
+			0b01000100,
+			0b01000100,
+			0b00111000,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b00111000
+		},
+		// 9
+		{
+			0b00111000,
+			0b01000100,
+			0b01000100,
+			0b00111100,
+			0b00000100,
+			0b00000100,
+			0b01000100,
+			0b00111000
+		}
+	},
+	// Variante VIRGULE
+	{
+		// 0
+		{
+			0b00111000,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b00111001
+		},
+		// 1
+		{
+			0b00010000,
+			0b00110000,
+			0b01010000,
+			0b00010000,
+			0b00010000,
+			0b00010000,
+			0b00010000,
+			0b01111101
+		},
+		// 2
+		{
+			0b00111000,
+			0b01000100,
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b01000000,
+			0b01111101
+		},
+		// 3
+		{
+			0b00111000,
+			0b01000100,
+			0b00000100,
+			0b00011000,
+			0b00011000,
+			0b00000100,
+			0b01000100,
+			0b00111001
+		},
+		// 4
+		{
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b01001000,
+			0b01111100,
+			0b00001000,
+			0b00001001
+		},
+		// 5
+		{
+			0b01111100,
+			0b01000000,
+			0b01000000,
+			0b01111000,
+			0b00000100,
+			0b00000100,
+			0b01000100,
+			0b00111001
+		},
+		// 6
+		{
+			0b00111000,
+			0b01000100,
+			0b01000000,
+			0b01111000,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b00111001
+		},
+		// 7
+		{
+			0b01111100,
+			0b00000100,
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b01000000,
+			0b01000001
+		},
+		// 8
+		{
+			0b00111000,
+			0b01000100,
+			0b01000100,
+			0b00111000,
+			0b01000100,
+			0b01000100,
+			0b01000100,
+			0b00111001
+		},
+		// 9
+		{
+			0b00111000,
+			0b01000100,
+			0b01000100,
+			0b00111100,
+			0b00000100,
+			0b00000100,
+			0b01000100,
+			0b00111001
+		}
+	},
+	// Variante DECALEE
+	{
+		// 0
+		{
+			0b00011100,
+			0b00100010,
+			0b00100010,
+			0b00100010,
+			0b00100010,
+			0b00100010,
+			0b00100010,
+			0b00011100
+		},
+		// 1
+		{
+			0b00001000,
+			0b00011000,
+			0b00101000,
+			0b00001000,
+			0b00001000,
+			0b00001000,
+			0b00001000,
+			0b00111110
+		},
+		// 2
+		{
+			0b00011100,
+			0b00100010,
+			0b00000010,
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b00111110
+		},
+		// 3
+		{
+			0b00011100,
+			0b00100010,
+			0b00000010,
+			0b00001100,
+			0b00001100,
+			0b00000010,
+			0b00100010,
+			0b00011100
+		},
+		// 4
+		{
+			0b00000010,
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100100,
+			0b00111110,
+			0b00000100,
+			0b00000100
+		},
+		// 5
+		{
+			0b00111110,
+			0b00100000,
+			0b00100000,
+			0b00111100,
+			0b00000010,
+			0b00000010,
+			0b00100010,
+			0b00011100
+		},
+		// 6
+		{
+			0b00011100,
+			0b00100010,
+			0b00100000,
+			0b00111100,
+			0b00100010,
+			0b00100010,
+			0b00100010,
+			0b00011100
+		},
+		// 7
+		{
+			0b00111110,
+			0b00000010,
+			0b00000010,
+			0b00000100,
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b00100000
+		},
+		// 8
+		{
+			0b00011100,
+			0b00100010,
+			0b00100010,
+			0b00011100,
+			0b00100010,
+			0b00100010,
+			0b00100010,
+			0b00011100
+		},
+		// 9
+		{
+			0b00011100,
+			0b00100010,
+			0b00100010,
+			0b00011110,
+			0b00000010,
+			0b00000010,
+			0b00100010,
+			0b00011100
+		}
+	},
+	// Variante DEUX_POINTS
+	{
+		// 0
+		{
+			0b01110000,
+			0b10001000,
+			0b10001000,
+			0b10001001,
+			0b10001000,
+			0b10001000,
+			0b10001001,
+			0b01110000
+		},
+		// 1
+		{
+			0b00100000,
+			0b01100000,
+			0b10100000,
+			0b00100001,
+			0b00100000,
+			0b00100000,
+			0b00100001,
+			0b11111000
+		},
+		// 2
+		{
+			0b01110000,
+			0b10001000,
+			0b00001000,
+			0b00010001,
+			0b00100000,
+			0b01000000,
+			0b10000001,
+			0b11111000
+		},
+		// 3
+		{
+			0b01110000,
+			0b10001000,
+			0b00001000,
+			0b00110001,
+			0b00110000,
+			0b00001000,
+			0b10001001,
+			0b01110000
+		},
+		// 4
+		{
+			0b00001000,
+			0b00010000,
+			0b00100000,
+			0b01000001,
+			0b10010000,
+			0b11111000,
+			0b00010001,
+			0b00010000
+		},
+		// 5
+		{
+			0b11111000,
+			0b10000000,
+			0b10000000,
+			0b11110001,
+			0b00001000,
+			0b00001000,
+			0b10001001,
+			0b01110000
+		},
+		// 6
+		{
+			0b01110000,
+			0b10001000,
+			0b10000000,
+			0b11110001,
+			0b10001000,
+			0b10001000,
+			0b10001001,
+			0b01110000
+		},
+		// 7
+		{
+			0b11111000,
+			0b00001000,
+			0b00001000,
+			0b00010001,
+			0b00100000,
+			0b01000000,
+			0b10000001,
+			0b10000000
+		},
+		// 8
+		{
+			0b01110000,
+			0b10001000,
+			0b10001000,
+			0b01110001,
+			0b10001000,
+			0b10001000,
+			0b10001001,
+			0b01110000
+		},
+		// 9
+		{
+			0b01110000,
+			0b10001000,
+			0b10001000,
+			0b01111001,
+			0b00001000,
+			0b00001000,
+			0b10001001,
+			0b01110000
+		}
+	}
 };
 
-uint8_t neufDp [] = {
-	0b01110000,
-	0b10001000,
-	0b10001000,
-	0b01111001,
-	0b00001000,
-	0b00001000,
-	0b10001001,
-	0b01110000
+/**
+ *   \brief   Symboles, indice : code du symbole - NB_CHIFFRES
+ */ 
+const uint8_t symboles[NB_SYMBOLES][8] PROGMEM = {
+	// DEGRE
+	{
+		0b00000000,
+		0b00111000,
+		0b00101000,
+		0b00111000,
+		0b00000000,
+		0b00000000,
+		0b00000000,
+		0b00000000
+	},
+	// POURCENT
+	{
+		0b00000000,
+		0b01100010,
+		0b01100100,
+		0b00001000,
+		0b00010000,
+		0b00100110,
+		0b01000110,
+		0b00000000
+	},
+	// MOINS
+	{
+		0b00000000,
+		0b00000000,
+		0b00000000,
+		0b00000000,
+		0b01111100,
+		0b00000000,
+		0b00000000,
+		0b00000000
+	}
 };
 
+/**
+ * \brief Donne une ligne d'un caractère
+ *
+ * \details Lecture directe dans les tables en flash, sans aiguillage.
+ *          Un code inconnu donne une matrice éteinte.
+ *
+ * \param pVariante la variante du chiffre (VARIANTE_xxx), ignorée pour les symboles
+ * \param pCode le chiffre (0 à 9) ou le symbole (CAR_xxx)
+ * \param pLigne la ligne du caractère
+ *
+ * \return les pixels de la ligne, bit 7 à gauche
+ */
+static inline uint8_t ligneGlyphe(uint8_t pVariante, uint8_t pCode, uint8_t pLigne)
+{
+	if(pCode < NB_CHIFFRES) {
+		return(pgm_read_byte(&chiffres[pVariante][pCode][pLigne]));
+	}
+	if(pCode < NB_CHIFFRES + NB_SYMBOLES) {
+		return(pgm_read_byte(&symboles[pCode - NB_CHIFFRES][pLigne]));
+	}
+	return(0x00);
+}
 
 #endif	//Chiffres_h
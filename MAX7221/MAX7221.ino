@@ -64,18 +64,7 @@ void reset() {
  * @param la ligne du chiffre  
  */
 uint8_t segment(uint8_t pValeur, uint8_t pLigne){
-  switch(pValeur) {
-    case 0: return(zero[pLigne]);
-    case 1: return(un[pLigne]);
-    case 2: return(deux[pLigne]);
-    case 3: return(trois[pLigne]);
-    case 4: return(quatre[pLigne]);
-    case 5: return(cinq[pLigne]);
-    case 6: return(six[pLigne]);
-    case 7: return(sept[pLigne]);
-    case 8: return(huit[pLigne]);
-    case 9: return(neuf[pLigne]);
-  }
+  return(ligneGlyphe(VARIANTE_NORMALE, pValeur, pLigne));
 }
 
 /**
@@ -85,18 +74,7 @@ uint8_t segment(uint8_t pValeur, uint8_t pLigne){
  * @param la ligne du chiffre  
  */
 uint8_t segmentDp(uint8_t pValeur, uint8_t pLigne){
-  switch(pValeur) {
-    case 0: return(zeroDp[pLigne]);
-    case 1: return(unDp[pLigne]);
-    case 2: return(deuxDp[pLigne]);
-    case 3: return(troisDp[pLigne]);
-    case 4: return(quatreDp[pLigne]);
-    case 5: return(cinqDp[pLigne]);
-    case 6: return(sixDp[pLigne]);
-    case 7: return(septDp[pLigne]);
-    case 8: return(huitDp[pLigne]);
-    case 9: return(neufDp[pLigne]);
-  }
+  return(ligneGlyphe(VARIANTE_DEUX_POINTS, pValeur, pLigne));
 }
 
 /**
@@ -106,18 +84,7 @@ uint8_t segmentDp(uint8_t pValeur, uint8_t pLigne){
  * @param la ligne du chiffre  
  */
 uint8_t segmentDm(uint8_t pValeur, uint8_t pLigne){
-  switch(pValeur) {
-    case 0: return(zeroDm[pLigne]);
-    case 1: return(unDm[pLigne]);
-    case 2: return(deuxDm[pLigne]);
-    case 3: return(troisDm[pLigne]);
-    case 4: return(quatreDm[pLigne]);
-    case 5: return(cinqDm[pLigne]);
-    case 6: return(sixDm[pLigne]);
-    case 7: return(septDm[pLigne]);
-    case 8: return(huitDm[pLigne]);
-    case 9: return(neufDm[pLigne]);
-  }
+  return(ligneGlyphe(VARIANTE_DECALEE, pValeur, pLigne));
 }
 
 // *****************************************
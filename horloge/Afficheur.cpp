@@ -0,0 +1,131 @@
+/*!
+ *   \file    Afficheur.cpp
+ *   \brief   Regroupement des chaines de matrices d'un même bus
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include "Afficheur.h"
+
+/**
+ * \brief   Constructeur.
+ *
+ * \details Aucune chaine, elles sont ajoutées par ajoute()
+ *
+ * \param   pBus Le bus SPI des chaines
+ */
+Afficheur::Afficheur(BusSpi &pBus) : bus(pBus)
+{
+	nbChaines = 0;
+}
+
+/**
+ * \brief Ajoute une chaine
+ *
+ * \details La chaine passe en application différée
+ *
+ * \param pChaine la chaine, sur le bus de l'afficheur
+ *
+ * \return false si NB_CHAINES_MAX chaines sont déjà ajoutées
+ */
+bool Afficheur::ajoute(ChaineMatrices &pChaine)
+{
+	if(nbChaines == NB_CHAINES_MAX) {
+		return(false);
+	}
+	pChaine.differe(true);
+	chaines[nbChaines++] = &pChaine;
+	return(true);
+}
+
+/**
+ * \brief Applique les images de toutes les chaines
+ *
+ * \details Seules les lignes modifiées sont envoyées, en une seule salve
+ */
+void Afficheur::commit(void)
+{
+	ChaineMatrices::applique(chaines, nbChaines);
+}
+
+/**
+ * \brief Durée du dernier commit
+ *
+ * \details Attend la fin de la salve en cours, un commit étant mis en file d'un bloc
+ *          et envoyé par l'interruption
+ *
+ * \return la durée en µs
+ */
+unsigned long Afficheur::latence(void)
+{
+	bus.attente();
+	return(bus.duree());
+}
+
+/**
+ * \brief   Réglage de l'intensité de toutes les chaines
+ *
+ * \param   pIntensity L'intensité, entre 0x00 et 0x0F
+ */
+void Afficheur::intensity(uint8_t pIntensity)
+{
+	for(uint8_t chaine = 0; chaine != nbChaines; chaine++) {
+		chaines[chaine]->intensity(pIntensity);
+	}
+}
+
+/**
+ * \brief   Mise en veille de toutes les chaines
+ *
+ * \param   pVeille true pour éteindre, false pour rallumer
+ */
+void Afficheur::veille(bool pVeille)
+{
+	for(uint8_t chaine = 0; chaine != nbChaines; chaine++) {
+		chaines[chaine]->veille(pVeille);
+	}
+}
+
+/**
+ * \brief   Etat de veille
+ *
+ * \return  true si toutes les chaines sont éteintes
+ */
+bool Afficheur::enVeille(void)
+{
+	for(uint8_t chaine = 0; chaine != nbChaines; chaine++) {
+		if(!chaines[chaine]->enVeille()) {
+			return(false);
+		}
+	}
+	return(true);
+}
+
+/**
+ * \brief   Nombre total de matrices
+ *
+ * \return  la somme des longueurs des chaines
+ */
+uint8_t Afficheur::modules(void)
+{
+	uint8_t total = 0;
+	for(uint8_t chaine = 0; chaine != nbChaines; chaine++) {
+		total += chaines[chaine]->modules();
+	}
+	return(total);
+}
+
+/**
+ * \brief   Destructeur.
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+Afficheur::~Afficheur(void)
+{
+}
+
+/*! \class Afficheur
+ *  \brief Chaines de matrices appliquées ensemble en une salve du bus SPI partagé.
+ *
+ */
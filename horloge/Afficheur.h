@@ -0,0 +1,44 @@
+/*!
+ *   \file    Afficheur.h
+ *   \brief   Entete du regroupement des chaines de matrices d'un même bus
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#ifndef AFFICHEUR_H_
+#define AFFICHEUR_H_
+
+#include <stdint.h>
+#include "BusSpi.h"
+#include "ChaineMatrices.h"
+
+/**
+ *   \brief   Chaines de MAX7219 sur des broches CS différentes d'un même bus SPI
+ *
+ *   \details Les chaines ajoutées sont différées : leurs affichages ne font que dessiner
+ *            et commit() envoie toutes les images en une seule salve, lignes entrelacées.
+ *            La durée d'un commit dépend des octets envoyés, pas du nombre de chaines.
+ */
+class Afficheur {
+	public:
+		Afficheur(BusSpi &);
+
+		bool ajoute(ChaineMatrices &);
+		void commit(void);
+		unsigned long latence(void);
+
+		void intensity(uint8_t);
+		void veille(bool);
+		bool enVeille(void);
+		uint8_t modules(void);
+
+		virtual ~Afficheur(void);
+
+	private:
+		BusSpi &bus;
+		ChaineMatrices *chaines[NB_CHAINES_MAX];
+		uint8_t nbChaines;
+};
+
+#endif
@@ -0,0 +1,295 @@
+/*!
+ *   \file    Bmp180.cpp
+ *   \brief   Pilote non bloquant du BMP180
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "Bmp180.h"
+
+/**
+ *   \brief   Registres du BMP180
+ */ 
+#define REGISTRE_CALIBRATION 0xAA
+#define REGISTRE_ID          0xD0
+#define REGISTRE_CONTROLE    0xF4
+#define REGISTRE_DONNEES     0xF6
+
+/**
+ *   \brief   Commandes de conversion
+ */ 
+#define COMMANDE_TEMPERATURE 0x2E
+#define COMMANDE_PRESSION    0x34
+
+/**
+ *   \brief   Temps de conversion en µs, température puis pression selon le mode
+ *
+ *   \details Valeurs de la librairie Adafruit, un peu au-delà des maxima de la documentation
+ */ 
+#define DUREE_TEMPERATURE 5000
+static const uint16_t dureesPression[] = {5000, 8000, 14000, 26000};
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details Le capteur est initialisé par begin()
+ */
+Bmp180::Bmp180(void)
+{
+	calibre = false;
+	surechantillonnage = BMP180_ULTRAHAUTE;
+	etat = BMP180_REPOS;
+	modeCycle = BMP180_ULTRAHAUTE;
+	utCycle = 0;
+	debut = 0;
+	duree = 0;
+	ut = 0;
+	up = 0;
+	modeMesure = BMP180_ULTRAHAUTE;
+}
+
+/**
+ * \brief Initialise le capteur
+ *
+ * \details Vérifie l'identifiant et lit la calibration
+ *
+ * \param pMode le suréchantillonnage (BMP180_xxx)
+ *
+ * \return false si le capteur ne répond pas
+ */
+bool Bmp180::begin(uint8_t pMode)
+{
+	Wire.begin();
+	mode(pMode);
+	calibre = false;
+	if(lecture8(REGISTRE_ID) != BMP180_ID) {
+		return(false);
+	}
+
+	ac1 = lecture16(REGISTRE_CALIBRATION);
+	ac2 = lecture16(REGISTRE_CALIBRATION + 2);
+	ac3 = lecture16(REGISTRE_CALIBRATION + 4);
+	ac4 = lecture16(REGISTRE_CALIBRATION + 6);
+	ac5 = lecture16(REGISTRE_CALIBRATION + 8);
+	ac6 = lecture16(REGISTRE_CALIBRATION + 10);
+	b1 = lecture16(REGISTRE_CALIBRATION + 12);
+	b2 = lecture16(REGISTRE_CALIBRATION + 14);
+	mb = lecture16(REGISTRE_CALIBRATION + 16);
+	mc = lecture16(REGISTRE_CALIBRATION + 18);
+	md = lecture16(REGISTRE_CALIBRATION + 20);
+	calibre = true;
+	return(true);
+}
+
+/**
+ * \brief Indique si le capteur a répondu à begin()
+ *
+ * \return true si la calibration est lue
+ */
+bool Bmp180::present(void)
+{
+	return(calibre);
+}
+
+/**
+ * \brief Choix du suréchantillonnage
+ *
+ * \details Pris en compte au prochain cycle de mesure
+ *
+ * \param pMode BMP180_ULTRABASSE (5 ms) à BMP180_ULTRAHAUTE (26 ms)
+ */
+void Bmp180::mode(uint8_t pMode)
+{
+	if(pMode > BMP180_ULTRAHAUTE) {
+		pMode = BMP180_ULTRAHAUTE;
+	}
+	surechantillonnage = pMode;
+}
+
+/**
+ * \brief Démarre un cycle de mesure
+ *
+ * \details Sans effet si un cycle est en cours ou si le capteur n'a pas répondu à begin()
+ */
+void Bmp180::demarre(void)
+{
+	if(etat != BMP180_REPOS || !calibre) {
+		return;
+	}
+	modeCycle = surechantillonnage;
+	conversion(COMMANDE_TEMPERATURE, DUREE_TEMPERATURE);
+	etat = BMP180_TEMPERATURE;
+}
+
+/**
+ * \brief Avance le cycle de mesure, à appeler souvent
+ *
+ * \details Ne fait rien tant que la conversion en cours n'est pas terminée.
+ *
+ * \return true quand un nouveau couple température/pression est disponible
+ */
+bool Bmp180::collecte(void)
+{
+	if(etat == BMP180_REPOS || micros() - debut < duree) {
+		return(false);
+	}
+
+	if(etat == BMP180_TEMPERATURE) {
+		utCycle = lecture16(REGISTRE_DONNEES);
+		conversion(COMMANDE_PRESSION + (modeCycle << 6), dureesPression[modeCycle]);
+		etat = BMP180_PRESSION;
+		return(false);
+	}
+
+	// Pression sur 19 bits au plus, selon le suréchantillonnage
+	uint32_t brut = (uint32_t)lecture16(REGISTRE_DONNEES) << 8;
+	brut |= lecture8(REGISTRE_DONNEES + 2);
+	up = brut >> (8 - modeCycle);
+	ut = utCycle;
+	modeMesure = modeCycle;
+	etat = BMP180_REPOS;
+	return(true);
+}
+
+/**
+ * \brief Indique si un cycle de mesure est en cours
+ *
+ * \return true entre demarre() et la fin du cycle
+ */
+bool Bmp180::occupe(void)
+{
+	return(etat != BMP180_REPOS);
+}
+
+/**
+ * \brief Lance une conversion
+ *
+ * \param pCommande la commande du registre de contrôle
+ * \param pDuree le temps de conversion en µs
+ */
+void Bmp180::conversion(uint8_t pCommande, unsigned long pDuree)
+{
+	ecriture8(REGISTRE_CONTROLE, pCommande);
+	debut = micros();
+	duree = pDuree;
+}
+
+/**
+ * \brief Paramètre B5 de la compensation, commun à la température et à la pression
+ */
+int32_t Bmp180::b5(void)
+{
+	int32_t x1 = (ut - (int32_t)ac6) * ((int32_t)ac5) >> 15;
+	int32_t x2 = ((int32_t)mc << 11) / (x1 + (int32_t)md);
+	return(x1 + x2);
+}
+
+/**
+ * \brief Température du dernier cycle
+ *
+ * \return la température en °C, au 1/10 de degré
+ */
+float Bmp180::temperature(void)
+{
+	float temperature = (b5() + 8) >> 4;
+	return(temperature / 10);
+}
+
+/**
+ * \brief Pression du dernier cycle
+ *
+ * \details Compensation de la documentation du BMP180, comme la librairie Adafruit
+ *
+ * \return la pression en Pa
+ */
+int32_t Bmp180::pression(void)
+{
+	int32_t b6 = b5() - 4000;
+	int32_t x1 = ((int32_t)b2 * ((b6 * b6) >> 12)) >> 11;
+	int32_t x2 = ((int32_t)ac2 * b6) >> 11;
+	int32_t x3 = x1 + x2;
+	int32_t b3 = ((((int32_t)ac1 * 4 + x3) << modeMesure) + 2) / 4;
+
+	x1 = ((int32_t)ac3 * b6) >> 13;
+	x2 = ((int32_t)b1 * ((b6 * b6) >> 12)) >> 16;
+	x3 = ((x1 + x2) + 2) >> 2;
+	uint32_t b4 = ((uint32_t)ac4 * (uint32_t)(x3 + 32768)) >> 15;
+	uint32_t b7 = ((uint32_t)up - b3) * (uint32_t)(50000UL >> modeMesure);
+
+	int32_t p;
+	if(b7 < 0x80000000) {
+		p = (b7 * 2) / b4;
+	} else {
+		p = (b7 / b4) * 2;
+	}
+	x1 = (p >> 8) * (p >> 8);
+	x1 = (x1 * 3038) >> 16;
+	x2 = (-7357 * p) >> 16;
+	return(p + ((x1 + x2 + (int32_t)3791) >> 4));
+}
+
+/**
+ * \brief Pression du dernier cycle ramenée au niveau de la mer
+ *
+ * \param pAltitude l'altitude du capteur en m
+ *
+ * \return la pression en Pa
+ */
+int32_t Bmp180::pressionMer(float pAltitude)
+{
+	return((int32_t)(pression() / pow(1.0 - pAltitude / 44330, 5.255)));
+}
+
+/**
+ * \brief Lecture d'un registre 8 bits
+ */
+uint8_t Bmp180::lecture8(uint8_t pRegistre)
+{
+	Wire.beginTransmission(BMP180_ADRESSE);
+	Wire.write(pRegistre);
+	Wire.endTransmission();
+	Wire.requestFrom((uint8_t)BMP180_ADRESSE, (uint8_t)1);
+	return(Wire.read());
+}
+
+/**
+ * \brief Lecture d'un registre 16 bits, poids fort en premier
+ */
+uint16_t Bmp180::lecture16(uint8_t pRegistre)
+{
+	Wire.beginTransmission(BMP180_ADRESSE);
+	Wire.write(pRegistre);
+	Wire.endTransmission();
+	Wire.requestFrom((uint8_t)BMP180_ADRESSE, (uint8_t)2);
+	uint16_t valeur = Wire.read() << 8;
+	valeur |= Wire.read();
+	return(valeur);
+}
+
+/**
+ * \brief Ecriture d'un registre 8 bits
+ */
+void Bmp180::ecriture8(uint8_t pRegistre, uint8_t pValeur)
+{
+	Wire.beginTransmission(BMP180_ADRESSE);
+	Wire.write(pRegistre);
+	Wire.write(pValeur);
+	Wire.endTransmission();
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+Bmp180::~Bmp180(void)
+{
+}
+
+/*! \class Bmp180 
+ *  \brief Pilote du BMP180 en deux temps : démarrage puis collecte des conversions.
+ *
+ */
@@ -0,0 +1,97 @@
+/*!
+ *   \file    Bmp180.h
+ *   \brief   Entete du pilote non bloquant du BMP180
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef BMP180_H_
+#define BMP180_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Adresse I2C du BMP180
+ */ 
+#define BMP180_ADRESSE 0x77
+
+/**
+ *   \brief   Identifiant du BMP180 (registre 0xD0)
+ */ 
+#define BMP180_ID 0x55
+
+/**
+ *   \brief   Modes de suréchantillonnage de la pression
+ */ 
+#define BMP180_ULTRABASSE 0
+#define BMP180_STANDARD   1
+#define BMP180_HAUTE      2
+#define BMP180_ULTRAHAUTE 3
+
+/**
+ *   \brief   Etats d'un cycle de mesure
+ */ 
+#define BMP180_REPOS       0
+#define BMP180_TEMPERATURE 1
+#define BMP180_PRESSION    2
+
+/**
+ *   \brief   Pilote du BMP180 sans attente
+ *
+ *   \details Un cycle de mesure est démarré par demarre() puis avancé par collecte() :
+ *            conversion de la température puis de la pression, 
+ *            chacune lue une fois son temps de conversion écoulé.
+ *            Compensation identique à la librairie Adafruit_BMP085.
+ *            Sans réponse du capteur à begin(), la calibration reste nulle : 
+ *            aucun cycle n'est démarré, la compensation diviserait par zéro.
+ */ 
+class Bmp180 {
+	public:
+		Bmp180(void);
+		
+		bool begin(uint8_t);
+		bool present(void);
+		void mode(uint8_t);
+		
+		void demarre(void);
+		bool collecte(void);
+		bool occupe(void);
+		
+		float temperature(void);
+		int32_t pression(void);
+		int32_t pressionMer(float);
+		
+		virtual ~Bmp180(void);
+		
+	private:
+		uint8_t lecture8(uint8_t);
+		uint16_t lecture16(uint8_t);
+		void ecriture8(uint8_t, uint8_t);
+		void conversion(uint8_t, unsigned long);
+		int32_t b5(void);
+		
+		// Calibration lue dans l'EEPROM du capteur
+		int16_t ac1, ac2, ac3, b1, b2, mb, mc, md;
+		uint16_t ac4, ac5, ac6;
+		
+		// Capteur identifié et calibration lue par begin()
+		bool calibre;
+		
+		// Suréchantillonnage des prochaines conversions
+		uint8_t surechantillonnage;
+		
+		// Cycle en cours
+		uint8_t etat;
+		uint8_t modeCycle;
+		int32_t utCycle;
+		unsigned long debut;
+		unsigned long duree;
+		
+		// Valeurs brutes du dernier cycle complet
+		int32_t ut;
+		int32_t up;
+		uint8_t modeMesure;
+};
+
+#endif
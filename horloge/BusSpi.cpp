@@ -0,0 +1,233 @@
+/*!
+ *   \file    BusSpi.cpp
+ *   \brief   Pilote SPI à file d'émission sur interruption
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "BusSpi.h"
+
+/**
+ *   \brief   Bus servi par l'interruption
+ */ 
+static BusSpi *busActif = 0;
+
+#ifdef SPI_STC_vect
+/**
+ * \brief   Interruption de fin de transfert d'un octet
+ */
+ISR(SPI_STC_vect)
+{
+	busActif->interruption();
+}
+#endif
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details File vide, le SPI est démarré par begin()
+ */
+BusSpi::BusSpi(void)
+{
+	frequence = FREQUENCE_SPI_FILE;
+	tete = 0;
+	queue = 0;
+	restant = 0;
+	csCourant = 0;
+	actif = false;
+	debut = 0;
+	dureeSalve = 0;
+	busActif = this;
+}
+
+/**
+ * \brief Démarre le SPI
+ *
+ * \details Peut être appelé par chaque utilisateur du bus.
+ *          Les trames partent à FREQUENCE_SPI_FILE, ou moins si un périphérique l'exige.
+ *
+ * \param pFrequence la fréquence maximale du périphérique
+ */
+void BusSpi::begin(uint32_t pFrequence)
+{
+	if(pFrequence < frequence) {
+		frequence = pFrequence;
+	}
+	SPI.begin();
+}
+
+/**
+ * \brief Place libre dans la file
+ *
+ * \details Un octet reste toujours libre pour distinguer file pleine et file vide
+ */
+uint8_t BusSpi::libre(void)
+{
+	return((uint8_t)(queue - tete - 1));
+}
+
+/**
+ * \brief Envoie une trame
+ *
+ * \details La broche CS est basse pendant toute la trame.
+ *          Si la file est pleine, attend la place nécessaire.
+ *
+ * \param pCs la broche CS du destinataire
+ * \param pOctets les octets de la trame, copiés
+ * \param pLongueur le nombre d'octets, entre 1 et TAILLE_FILE_SPI - 3
+ */
+void BusSpi::envoi(uint8_t pCs, const uint8_t *pOctets, uint8_t pLongueur)
+{
+#ifdef SPI_STC_vect
+	while(libre() < pLongueur + 2) {
+		patiente();
+	}
+	
+	uint8_t index = tete;
+	file[index++] = pCs;
+	file[index++] = pLongueur;
+	for(uint8_t octet = 0; octet != pLongueur; octet++) {
+		file[index++] = pOctets[octet];
+	}
+	
+	uint8_t sreg = SREG;
+	cli();
+	// La trame n'est visible de l'interruption qu'une fois complète
+	tete = index;
+	if(!actif) {
+		actif = true;
+		debut = micros();
+		SPI.beginTransaction(SPISettings(frequence, MSBFIRST, SPI_MODE0));
+		SPCR |= _BV(SPIE);
+		trameSuivante();
+	}
+	SREG = sreg;
+#else
+	debut = micros();
+	SPI.beginTransaction(SPISettings(frequence, MSBFIRST, SPI_MODE0));
+	digitalWrite(pCs, LOW);
+	for(uint8_t octet = 0; octet != pLongueur; octet++) {
+		SPI.transfer(pOctets[octet]);
+	}
+	digitalWrite(pCs, HIGH);
+	SPI.endTransaction();
+	dureeSalve = micros() - debut;
+#endif
+}
+
+/**
+ * \brief Attente active d'un octet
+ *
+ * \details La file se vide sous interruption. Interruptions masquées
+ *          (constructeurs des objets globaux, avant init()), la fin de transfert est scrutée.
+ */
+void BusSpi::patiente(void)
+{
+#ifdef SPI_STC_vect
+	if(!(SREG & _BV(SREG_I)) && (SPSR & _BV(SPIF))) {
+		interruption();
+	}
+#endif
+}
+
+/**
+ * \brief Commence la trame en tête de file
+ *
+ * \attention interruptions masquées ou sous interruption
+ */
+void BusSpi::trameSuivante(void)
+{
+	csCourant = file[queue++];
+	restant = file[queue++];
+	digitalWrite(csCourant, LOW);
+	restant--;
+#ifdef SPI_STC_vect
+	SPDR = file[queue++];
+#endif
+}
+
+/**
+ * \brief Octet suivant, appelé par l'interruption SPI_STC
+ *
+ * \details Fin de trame : CS remonte, puis trame suivante ou fin de la salve
+ */
+void BusSpi::interruption(void)
+{
+#ifdef SPI_STC_vect
+	if(restant != 0) {
+		restant--;
+		SPDR = file[queue++];
+		return;
+	}
+	digitalWrite(csCourant, HIGH);
+	if(queue != tete) {
+		trameSuivante();
+		return;
+	}
+	SPCR &= ~_BV(SPIE);
+	SPI.endTransaction();
+	actif = false;
+	dureeSalve = micros() - debut;
+#endif
+}
+
+/**
+ * \brief Indique si des trames sont en cours d'envoi
+ *
+ * \return true tant que la file n'est pas vide
+ */
+bool BusSpi::occupe(void)
+{
+	return(actif);
+}
+
+/**
+ * \brief Attend la fin de l'envoi des trames
+ *
+ * \details A utiliser avant de mettre l'horloge SPI en sommeil
+ */
+void BusSpi::attente(void)
+{
+	while(actif) {
+		patiente();
+	}
+}
+
+/**
+ * \brief Durée de la dernière salve
+ *
+ * \details D'une trame envoyée bus libre jusqu'à la file vide.
+ *          En envoi synchrone, durée de la dernière trame.
+ *
+ * \return la durée en µs
+ */
+unsigned long BusSpi::duree(void)
+{
+#ifdef SPI_STC_vect
+	// Lecture sur 4 octets, à l'abri de l'interruption
+	uint8_t sreg = SREG;
+	cli();
+	unsigned long valeur = dureeSalve;
+	SREG = sreg;
+	return(valeur);
+#else
+	return(dureeSalve);
+#endif
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+BusSpi::~BusSpi(void)
+{
+}
+
+/*! \class BusSpi 
+ *  \brief Bus SPI partagé, file d'émission vidée par l'interruption de fin de transfert.
+ *
+ */
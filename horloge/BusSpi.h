@@ -0,0 +1,79 @@
+/*!
+ *   \file    BusSpi.h
+ *   \brief   Entete du pilote SPI à file d'émission sur interruption
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef BUSSPI_H_
+#define BUSSPI_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Taille de la file d'émission en octets
+ *
+ *   \details 256 : les index sur 8 bits reviennent seuls au début de la file
+ */ 
+#define TAILLE_FILE_SPI 256
+
+/**
+ *   \brief   Fréquence SPI de l'émission sur interruption
+ *
+ *   \details Un octet à 1 MHz dure 128 cycles à 16 MHz, l'interruption en prend
+ *            moins de la moitié : le reste est disponible pour la boucle principale.
+ *            Au-delà, l'interruption occupe tout le temps d'un octet : à 8 MHz un octet 
+ *            dure 16 cycles, moins que l'entrée dans l'interruption.
+ *            Une trame dure donc environ 8 fois plus longtemps qu'en envoi bloquant à 8 MHz,
+ *            mais le processeur reste libre pendant l'envoi.
+ */ 
+#define FREQUENCE_SPI_FILE 1000000
+
+/**
+ *   \brief   Bus SPI partagé, émission de trames en tâche de fond
+ *
+ *   \details Chaque trame a sa broche CS, basse pendant toute la trame.
+ *            Sur l'AVR les octets sont envoyés par l'interruption SPI_STC,
+ *            envoi() rend la main dès la trame copiée dans la file.
+ *            Sans cette interruption (simulation sur PC), l'envoi est synchrone.
+ */ 
+class BusSpi {
+	public:
+		BusSpi(void);
+		
+		void begin(uint32_t);
+		void envoi(uint8_t, const uint8_t *, uint8_t);
+		bool occupe(void);
+		void attente(void);
+		unsigned long duree(void);
+		
+		void interruption(void);
+		
+		virtual ~BusSpi(void);
+		
+	private:
+		uint8_t libre(void);
+		void patiente(void);
+		void trameSuivante(void);
+		
+		// Fréquence des trames, la plus petite de FREQUENCE_SPI_FILE et de celle des périphériques
+		uint32_t frequence;
+		
+		// Trames : broche CS, longueur, octets
+		volatile uint8_t file[TAILLE_FILE_SPI];
+		// Index d'écriture, modifié seulement par envoi()
+		volatile uint8_t tete;
+		// Index de lecture, modifié seulement sous interruption pendant une salve
+		volatile uint8_t queue;
+		// Octets restant à envoyer de la trame en cours
+		volatile uint8_t restant;
+		volatile uint8_t csCourant;
+		volatile bool actif;
+		
+		// Durée de la dernière salve de trames en µs
+		volatile unsigned long debut;
+		volatile unsigned long dureeSalve;
+};
+
+#endif
@@ -0,0 +1,104 @@
+/*!
+ *   \file    Cadence.cpp
+ *   \brief   Cadence d'images basée sur le Timer3
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include "Cadence.h"
+
+/**
+ *   \brief   Image à dessiner, positionnée par l'interruption
+ */ 
+static volatile bool imageDue = false;
+
+/**
+ * \brief   Interruption de comparaison du Timer3, une par image
+ */
+ISR(TIMER3_COMPA_vect)
+{
+	imageDue = true;
+}
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details Le Timer3 n'est pas modifié avant demarre()
+ */
+Cadence::Cadence(void)
+{
+}
+
+/**
+ * \brief Démarre la cadence
+ *
+ * \details Timer3 en mode CTC, prédiviseur 64 : de 4 à 250 images par seconde à 16 MHz.
+ *          0 arrête la cadence, une cadence plus lente que CADENCE_MIN est ramenée à CADENCE_MIN.
+ *
+ * \param pImagesParSeconde le nombre d'images par seconde (ex. 30 à 60)
+ */
+void Cadence::demarre(uint8_t pImagesParSeconde)
+{
+	if(pImagesParSeconde == 0) {
+		arrete();
+		return;
+	}
+	if(pImagesParSeconde < CADENCE_MIN) {
+		pImagesParSeconde = CADENCE_MIN;
+	}
+	uint8_t sreg = SREG;
+	cli();
+	TCCR3A = 0;
+	TCCR3B = 0;
+	TCNT3 = 0;
+	OCR3A = F_CPU / PREDIVISEUR_CADENCE / pImagesParSeconde - 1;
+	TIFR3 = _BV(OCF3A);
+	TIMSK3 |= _BV(OCIE3A);
+	// CTC sur OCR3A, prédiviseur 64
+	TCCR3B = _BV(WGM32) | _BV(CS31) | _BV(CS30);
+	imageDue = false;
+	SREG = sreg;
+}
+
+/**
+ * \brief Arrête la cadence et le Timer3
+ */
+void Cadence::arrete(void)
+{
+	TIMSK3 &= ~_BV(OCIE3A);
+	TCCR3B = 0;
+	imageDue = false;
+}
+
+/**
+ * \brief Indique si une image est à dessiner
+ *
+ * \details Le signal est effacé par la lecture. 
+ *          Une image en retard n'est dessinée qu'une fois, les suivantes ne s'accumulent pas.
+ *
+ * \return true une fois par période de la cadence
+ */
+bool Cadence::image(void)
+{
+	if(!imageDue) {
+		return(false);
+	}
+	imageDue = false;
+	return(true);
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+Cadence::~Cadence(void)
+{
+}
+
+/*! \class Cadence 
+ *  \brief Cadence d'images sur interruption du Timer3, sans delay().
+ *
+ */
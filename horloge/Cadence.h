@@ -0,0 +1,41 @@
+/*!
+ *   \file    Cadence.h
+ *   \brief   Entete de la cadence d'images basée sur le Timer3
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef CADENCE_H_
+#define CADENCE_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Prédiviseur du Timer3
+ */ 
+#define PREDIVISEUR_CADENCE 64
+
+/**
+ *   \brief   Plus petite cadence, la période tenant dans les 16 bits de OCR3A
+ */ 
+#define CADENCE_MIN (F_CPU / PREDIVISEUR_CADENCE / 65536 + 1)
+
+/**
+ *   \brief   Cadence d'images pilotée par le Timer3 de l'ATmega32U4
+ *
+ *   \details L'interruption ne fait que signaler l'image, 
+ *            le dessin reste dans loop() entre les autres tâches.
+ */ 
+class Cadence {
+	public:
+		Cadence(void);
+		
+		void demarre(uint8_t);
+		void arrete(void);
+		bool image(void);
+		
+		virtual ~Cadence(void);
+};
+
+#endif
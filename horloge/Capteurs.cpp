@@ -0,0 +1,163 @@
+/*!
+ *   \file    Capteurs.cpp
+ *   \brief   Service d'échantillonnage des capteurs BMP180 et DHT22
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include "Capteurs.h"
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details Aucune mesure valide avant le premier échantillon
+ *
+ * \param   pBmp le capteur de pression et température
+ * \param   pDht le capteur de température et humidité
+ * \param   pAltitude l'altitude en m, pour la pression au niveau de la mer
+ */
+Capteurs::Capteurs(Bmp180 &pBmp, DHT_Unified &pDht, int16_t pAltitude) : bmp(pBmp), dht(pDht)
+{
+	altitude = pAltitude;
+	observateur = NULL;
+	lectureDht = 0;
+	for(uint8_t indice = 0; indice != NB_MESURES; indice++) {
+		mesures[indice].valeur = 0.0F;
+		mesures[indice].date = 0;
+		mesures[indice].valide = false;
+	}
+}
+
+/**
+ * \brief Echantillon du BMP180, tâche de période PERIODE_BMP
+ *
+ * \details Démarre seulement les conversions, le résultat est relevé par execute().
+ *          Capteur absent à l'initialisation : pression et température restent invalides.
+ */
+void Capteurs::echantillonneBmp(void)
+{
+	if(!bmp.present()) {
+		enregistre(MESURE_PRESSION, NAN);
+		enregistre(MESURE_TEMPERATURE_BMP, NAN);
+		return;
+	}
+	bmp.demarre();
+}
+
+/**
+ * \brief Relève les conversions terminées, à appeler à chaque tour de boucle
+ *
+ * \details Pression au niveau de la mer en hPa et température en °C
+ */
+void Capteurs::execute(void)
+{
+	if(bmp.collecte()) {
+		enregistre(MESURE_PRESSION, (float)bmp.pressionMer(altitude) / 100.0F);
+		enregistre(MESURE_TEMPERATURE_BMP, bmp.temperature());
+	}
+}
+
+/**
+ * \brief Echantillon du DHT22, tâche de période PERIODE_DHT
+ *
+ * \details Température en °C et humidité relative en %.
+ *          Une lecture en échec (NaN) rend la mesure invalide.
+ *          Moins de INTERVALLE_DHT après la lecture précédente (tâche en avance après un retard), 
+ *          l'échantillon est sauté : la valeur rendue par la librairie ne serait pas nouvelle.
+ */
+void Capteurs::echantillonneDht(void)
+{
+	if(millis() - lectureDht < INTERVALLE_DHT) {
+		return;
+	}
+	sensors_event_t event;
+	dht.temperature().getEvent(&event);
+	// Relevée après la lecture, elle n'est pas antérieure à celle de la librairie
+	lectureDht = millis();
+	enregistre(MESURE_TEMPERATURE_DHT, event.temperature);
+	// Même lecture du capteur, la librairie garde son résultat 2 s
+	dht.humidity().getEvent(&event);
+	enregistre(MESURE_HUMIDITE, event.relative_humidity);
+}
+
+/**
+ * \brief Fonction appelée à chaque échantillon, valide ou non
+ *
+ * \param pObservateur la fonction, NULL pour aucune
+ */
+void Capteurs::observe(FonctionEchantillon pObservateur)
+{
+	observateur = pObservateur;
+}
+
+/**
+ * \brief Mémorise une valeur lue
+ *
+ * \param pMesure la mesure (MESURE_xxx)
+ * \param pValeur la valeur, NaN si la lecture a échoué
+ */
+void Capteurs::enregistre(uint8_t pMesure, float pValeur)
+{
+	if(isnan(pValeur)) {
+		mesures[pMesure].valide = false;
+	} else {
+		mesures[pMesure].valeur = pValeur;
+		mesures[pMesure].date = millis();
+		mesures[pMesure].valide = true;
+	}
+	if(observateur != NULL) {
+		observateur(pMesure, mesures[pMesure].valide, pValeur);
+	}
+}
+
+/**
+ * \brief Indique si une mesure est utilisable
+ *
+ * \param pMesure la mesure (MESURE_xxx)
+ *
+ * \return true si la dernière lecture a réussi il y a moins de AGE_MAX_MESURE
+ */
+bool Capteurs::valide(uint8_t pMesure)
+{
+	return(mesures[pMesure].valide && millis() - mesures[pMesure].date < AGE_MAX_MESURE);
+}
+
+/**
+ * \brief Dernière valeur d'une mesure
+ *
+ * \param pMesure la mesure (MESURE_xxx)
+ *
+ * \return la valeur, sans signification si la mesure n'est pas valide
+ */
+float Capteurs::valeur(uint8_t pMesure)
+{
+	return(mesures[pMesure].valeur);
+}
+
+/**
+ * \brief Date de la dernière valeur d'une mesure
+ *
+ * \param pMesure la mesure (MESURE_xxx)
+ *
+ * \return la date en ms (millis())
+ */
+unsigned long Capteurs::date(uint8_t pMesure)
+{
+	return(mesures[pMesure].date);
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+Capteurs::~Capteurs(void)
+{
+}
+
+/*! \class Capteurs 
+ *  \brief Echantillonnage périodique des capteurs, dernière valeur datée et validée.
+ *
+ */
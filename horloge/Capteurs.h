@@ -0,0 +1,96 @@
+/*!
+ *   \file    Capteurs.h
+ *   \brief   Entete du service d'échantillonnage des capteurs BMP180 et DHT22
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef CAPTEURS_H_
+#define CAPTEURS_H_
+
+#include <stdint.h>
+#include <Adafruit_Sensor.h>
+#include <DHT_U.h>
+#include "Bmp180.h"
+
+/**
+ *   \brief   Mesures disponibles
+ */ 
+#define MESURE_PRESSION        0
+#define MESURE_TEMPERATURE_BMP 1
+#define MESURE_TEMPERATURE_DHT 2
+#define MESURE_HUMIDITE        3
+#define NB_MESURES             4
+
+/**
+ *   \brief   Intervalle minimal entre deux lectures du DHT22 en ms
+ *
+ *   \details En deçà, la librairie ne lit pas le capteur et rend sa lecture précédente
+ */ 
+#define INTERVALLE_DHT 2000
+
+/**
+ *   \brief   Périodes d'échantillonnage en ms
+ *
+ *   \details L'ordonnanceur rattrape un retard sur la période suivante : 
+ *            PERIODE_DHT garde une marge au-dessus de INTERVALLE_DHT
+ */ 
+#define PERIODE_BMP 1000
+#define PERIODE_DHT 2100
+
+/**
+ *   \brief   Age au-delà duquel une mesure n'est plus valide, en ms
+ *
+ *   \details Plusieurs échantillons manqués de suite
+ */ 
+#define AGE_MAX_MESURE 10000
+
+/**
+ *   \brief   Fonction appelée à chaque échantillon : mesure, validité et valeur
+ */ 
+typedef void (*FonctionEchantillon)(uint8_t, bool, float);
+
+/**
+ *   \brief   Echantillonnage des capteurs en tâche de fond
+ *
+ *   \details Chaque capteur est lu par sa propre tâche périodique, 
+ *            la dernière valeur est gardée avec sa date et sa validité.
+ *            Un affichage n'attend jamais de conversion,
+ *            celles du BMP180 se déroulent pendant la boucle principale.
+ */ 
+class Capteurs {
+	public:
+		Capteurs(Bmp180 &, DHT_Unified &, int16_t);
+		
+		void echantillonneBmp(void);
+		void echantillonneDht(void);
+		void execute(void);
+		void observe(FonctionEchantillon);
+		
+		bool valide(uint8_t);
+		float valeur(uint8_t);
+		unsigned long date(uint8_t);
+		
+		virtual ~Capteurs(void);
+		
+	private:
+		void enregistre(uint8_t, float);
+		
+		struct Mesure {
+			float valeur;
+			unsigned long date;
+			bool valide;
+		};
+		
+		Bmp180 &bmp;
+		DHT_Unified &dht;
+		int16_t altitude;
+		
+		Mesure mesures[NB_MESURES];
+		// Date de la dernière lecture du DHT22, réussie ou non
+		unsigned long lectureDht;
+		FonctionEchantillon observateur;
+};
+
+#endif
@@ -0,0 +1,153 @@
+/*!
+ *   \file    ChaineMatrices.cpp
+ *   \brief   Base des chaines de MAX7219, une par broche CS
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include "ChaineMatrices.h"
+
+/**
+ * \brief   Constructeur.
+ *
+ * \details Les MAX7219 sont initialisés par la classe dérivée,
+ *          qui seule connait la longueur de la chaine.
+ *
+ * \param   pBus Le bus SPI, partagé avec les autres chaines et périphériques
+ * \param   pCs La broche utilisée pour le CS SPI de cette chaine
+ * \param   pModules Le nombre de matrices de la chaine
+ */
+ChaineMatrices::ChaineMatrices(BusSpi &pBus, uint8_t pCs, uint8_t pModules) : bus(pBus)
+{
+	cs = pCs;
+	nbModules = pModules;
+	eteint = false;
+	differee = false;
+	redessine = false;
+
+	// Gestion broche CS
+	pinMode(cs, OUTPUT);
+}
+
+/**
+ * \brief   Réglage de l'intensité.
+ *
+ * \param   pIntensity L'intensité.
+ *
+ * \attention intensité entre 0x00 et 0x0F
+ */
+void ChaineMatrices::intensity(uint8_t pIntensity)
+{
+	commande(0x0A, pIntensity);
+}
+
+/**
+ * \brief   Mise en veille des matrices
+ *
+ * \details Registre shutdown : les MAX7219 gardent leurs registres
+ *          et consomment environ 150 µA chacun.
+ *          L'image reste modifiable pendant la veille, elle s'affiche au réveil.
+ *
+ * \param   pVeille true pour éteindre, false pour rallumer
+ */
+void ChaineMatrices::veille(bool pVeille)
+{
+	if(pVeille == eteint) {
+		return;
+	}
+	eteint = pVeille;
+	commande(0x0C, eteint ? 0x00 : 0x01);
+}
+
+/**
+ * \brief   Etat de veille des matrices
+ *
+ * \return  true si les matrices sont éteintes
+ */
+bool ChaineMatrices::enVeille(void)
+{
+	return(eteint);
+}
+
+/**
+ * \brief   Application différée de l'image
+ *
+ * \details Les affichages et le calque ne font plus que dessiner, l'image est envoyée
+ *          par Afficheur::commit() avec celles des autres chaines.
+ *          Les commandes (intensité, veille) restent immédiates.
+ *
+ * \param   pDiffere true pour différer
+ */
+void ChaineMatrices::differe(bool pDiffere)
+{
+	differee = pDiffere;
+}
+
+/**
+ * \brief   Longueur de la chaine
+ *
+ * \return  le nombre de matrices
+ */
+uint8_t ChaineMatrices::modules(void)
+{
+	return(nbModules);
+}
+
+/**
+ * \brief Applique l'image de plusieurs chaines en une seule salve
+ *
+ * \details Une ligne seule est écrite directement, l'écriture d'un registre étant atomique.
+ *          Une chaine redessinée dont plusieurs lignes changent est éteinte (registre shutdown)
+ *          le temps de les écrire : l'affichage passe de l'ancienne image au noir puis
+ *          à la nouvelle, sans image intermédiaire. Les images du défilement et le calque
+ *          sont écrits sans extinction.
+ *          Les lignes des chaines sont entrelacées : toutes les extinctions, la ligne 0
+ *          de chaque chaine, la ligne 1... puis tous les rallumages. Les fenêtres d'extinction
+ *          se recouvrent et la salve ne dure que le temps de ses octets.
+ *
+ * \param pChaines les chaines, au plus NB_CHAINES_MAX
+ * \param pNombre le nombre de chaines
+ */
+void ChaineMatrices::applique(ChaineMatrices * const *pChaines, uint8_t pNombre)
+{
+	uint8_t modifiees[NB_CHAINES_MAX];
+	uint8_t extinctions = 0;
+	for(uint8_t chaine = 0; chaine != pNombre; chaine++) {
+		modifiees[chaine] = pChaines[chaine]->lignesModifiees();
+		// Plus d'un bit à 1 : plusieurs lignes, inutile si les matrices sont en veille
+		bool redessine = pChaines[chaine]->redessine;
+		pChaines[chaine]->redessine = false;
+		if(redessine && !pChaines[chaine]->eteint && (modifiees[chaine] & (modifiees[chaine] - 1)) != 0) {
+			extinctions |= 1 << chaine;
+			pChaines[chaine]->commande(0x0C, 0x00);
+		}
+	}
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		for(uint8_t chaine = 0; chaine != pNombre; chaine++) {
+			if(modifiees[chaine] & (1 << ligne)) {
+				pChaines[chaine]->envoiLigne(ligne);
+			}
+		}
+	}
+	for(uint8_t chaine = 0; chaine != pNombre; chaine++) {
+		if(extinctions & (1 << chaine)) {
+			pChaines[chaine]->commande(0x0C, 0x01);
+		}
+	}
+}
+
+/**
+ * \brief   Destructeur.
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+ChaineMatrices::~ChaineMatrices(void)
+{
+}
+
+/*! \class ChaineMatrices
+ *  \brief Base des chaines de MAX7219 : commandes et application entrelacée de l'image.
+ *
+ */
@@ -0,0 +1,65 @@
+/*!
+ *   \file    ChaineMatrices.h
+ *   \brief   Entete de la base des chaines de MAX7219, une par broche CS
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#ifndef CHAINEMATRICES_H_
+#define CHAINEMATRICES_H_
+
+#include <stdint.h>
+#include "BusSpi.h"
+
+/**
+ *   \brief   Nombre de lignes d'une matrice
+ */
+#define NB_LIGNES 8
+
+/**
+ *   \brief   Nombre maximal de chaines appliquées ensemble
+ */
+#define NB_CHAINES_MAX 4
+
+/**
+ *   \brief   Chaine de MAX7219 sur sa broche CS, le bus SPI étant partagé
+ *
+ *   \details Partie commune à toutes les longueurs de chaine : registres de commande
+ *            et application de l'image, seule ou entrelacée avec d'autres chaines.
+ *            Une chaine différée n'envoie plus son image d'elle-même,
+ *            c'est l'Afficheur qui l'applique avec les autres.
+ */
+class ChaineMatrices {
+	friend class Afficheur;
+
+	public:
+		ChaineMatrices(BusSpi &, uint8_t, uint8_t);
+
+		void intensity(uint8_t);
+		void veille(bool);
+		bool enVeille(void);
+		void differe(bool);
+		uint8_t modules(void);
+
+		virtual ~ChaineMatrices(void);
+
+	protected:
+		static void applique(ChaineMatrices * const *, uint8_t);
+
+		virtual uint8_t lignesModifiees(void) = 0;
+		virtual void envoiLigne(uint8_t) = 0;
+		virtual void commande(uint8_t, uint8_t) = 0;
+
+		BusSpi &bus;
+		uint8_t cs;
+		uint8_t nbModules;
+		// Matrices éteintes par le registre shutdown
+		bool eteint;
+		// Image appliquée par l'Afficheur
+		bool differee;
+		// Nouveau dessin à appliquer derrière une extinction, pas une image du défilement
+		bool redessine;
+};
+
+#endif
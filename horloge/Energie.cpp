@@ -0,0 +1,201 @@
+/*!
+ *   \file    Energie.cpp
+ *   \brief   Gestion du sommeil de l'ATmega32U4 et bilan de consommation
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+#include "Energie.h"
+
+/**
+ *   \brief   Compteur de millis() du coeur Arduino (wiring.c)
+ */ 
+extern volatile unsigned long timer0_millis;
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details Bilan à zéro, matrices allumées à l'intensité minimale
+ */
+Energie::Energie(void)
+{
+	for(uint8_t etat = 0; etat != NB_ETATS; etat++) {
+		durees[etat] = 0;
+	}
+	affichagePondere = 0;
+	affichageEteint = 0;
+	nbMatrices = 0;
+	allume = true;
+	intensite = 0;
+	repere = 0;
+	dernierTop = 0;
+	topRecu = false;
+}
+
+/**
+ * \brief Endort le microcontrôleur jusqu'à la prochaine interruption
+ *
+ * \details En power-down le Timer0 est arrêté : au réveil par le top de seconde, 
+ *          millis() est avancé jusqu'à PERIODE_TOP après le top précédent.
+ *          Le réveil par une autre source n'est pas corrigé.
+ *
+ * \param pSommeil SOMMEIL_REPOS ou SOMMEIL_ARRET
+ *
+ * \attention SOMMEIL_ARRET sans SPI ni I2C en cours, et sans USB (l'hôte perdrait le port)
+ */
+void Energie::dort(uint8_t pSommeil)
+{
+	unsigned long debut = micros();
+	comptabilise(ETAT_ACTIF, debut - repere);
+
+	set_sleep_mode(pSommeil == SOMMEIL_ARRET ? SLEEP_MODE_PWR_DOWN : SLEEP_MODE_IDLE);
+	cli();
+	unsigned long avant = dernierTop;
+	// Un top arrivé depuis le dernier sommeil est d'abord traité par la boucle
+	bool dormi = !topRecu;
+	if(dormi) {
+		sleep_enable();
+		// L'instruction qui suit sei est toujours exécutée : pas d'interruption perdue avant le sommeil
+		sei();
+		sleep_cpu();
+		sleep_disable();
+	}
+	sei();
+
+	if(pSommeil == SOMMEIL_ARRET) {
+		unsigned long ajout = 0;
+		if(dormi && topRecu) {
+			uint8_t sreg = SREG;
+			cli();
+			unsigned long ecoule = timer0_millis - avant;
+			if(ecoule < PERIODE_TOP) {
+				ajout = PERIODE_TOP - ecoule;
+				timer0_millis += ajout;
+			}
+			dernierTop = timer0_millis;
+			SREG = sreg;
+		}
+		comptabilise(ETAT_ARRET, ajout * 1000UL);
+	} else {
+		comptabilise(ETAT_REPOS, micros() - debut);
+	}
+	topRecu = false;
+	repere = micros();
+}
+
+/**
+ * \brief Top de seconde, appelé par l'interruption SQW/OUT
+ */
+void Energie::top(void)
+{
+	dernierTop = millis();
+	topRecu = true;
+}
+
+/**
+ * \brief Etat des matrices pour le bilan
+ *
+ * \param pNbMatrices le nombre de matrices
+ * \param pAllume false si les matrices sont en veille
+ * \param pIntensite l'intensité (0x00 à 0x0F)
+ */
+void Energie::affichage(uint8_t pNbMatrices, bool pAllume, uint8_t pIntensite)
+{
+	nbMatrices = pNbMatrices;
+	allume = pAllume;
+	intensite = pIntensite;
+}
+
+/**
+ * \brief Ajoute une durée au bilan
+ *
+ * \param pEtat l'état (ETAT_xxx)
+ * \param pDuree la durée en µs
+ */
+void Energie::comptabilise(uint8_t pEtat, unsigned long pDuree)
+{
+	durees[pEtat] += pDuree;
+	if(allume) {
+		affichagePondere += (uint64_t)pDuree * (intensite + 1);
+	} else {
+		affichageEteint += pDuree;
+	}
+}
+
+/**
+ * \brief Durée passée dans un état
+ *
+ * \param pEtat l'état (ETAT_xxx)
+ *
+ * \return la durée en ms
+ */
+unsigned long Energie::duree(uint8_t pEtat)
+{
+	return((unsigned long)(durees[pEtat] / 1000));
+}
+
+/**
+ * \brief Durée matrices allumées ou éteintes
+ *
+ * \param pAllume true pour la durée allumées
+ *
+ * \return la durée en ms
+ */
+unsigned long Energie::dureeAffichage(bool pAllume)
+{
+	if(pAllume) {
+		uint64_t total = durees[ETAT_ACTIF] + durees[ETAT_REPOS] + durees[ETAT_ARRET];
+		return((unsigned long)((total - affichageEteint) / 1000));
+	}
+	return((unsigned long)(affichageEteint / 1000));
+}
+
+/**
+ * \brief Charge consommée estimée depuis le démarrage
+ *
+ * \details Durées par état multipliées par les courants estimés
+ *
+ * \return la charge en mAh
+ */
+float Energie::charge(void)
+{
+	// µA.s
+	float charge = (float)(durees[ETAT_ACTIF] / 1000) * COURANT_ACTIF / 1000.0F;
+	charge += (float)(durees[ETAT_REPOS] / 1000) * COURANT_REPOS / 1000.0F;
+	charge += (float)(durees[ETAT_ARRET] / 1000) * COURANT_ARRET / 1000.0F;
+	charge += (float)(affichagePondere / 1000) * nbMatrices * (COURANT_MATRICE_MAX / 16) / 1000.0F;
+	charge += (float)(affichageEteint / 1000) * nbMatrices * COURANT_MATRICE_ETEINTE / 1000.0F;
+	// µA.s en mAh
+	return(charge / 3600000.0F);
+}
+
+/**
+ * \brief Courant moyen estimé depuis le démarrage
+ *
+ * \return le courant en mA
+ */
+float Energie::courant(void)
+{
+	unsigned long total = duree(ETAT_ACTIF) + duree(ETAT_REPOS) + duree(ETAT_ARRET);
+	if(total == 0) {
+		return(0.0F);
+	}
+	return(charge() * 3600000.0F / total);
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+Energie::~Energie(void)
+{
+}
+
+/*! \class Energie 
+ *  \brief Sommeil idle ou power-down entre les évènements, bilan de consommation estimé.
+ *
+ */
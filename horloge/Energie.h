@@ -0,0 +1,94 @@
+/*!
+ *   \file    Energie.h
+ *   \brief   Entete de la gestion du sommeil de l'ATmega32U4 et du bilan de consommation
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef ENERGIE_H_
+#define ENERGIE_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Sommeils disponibles
+ *
+ *   \details SOMMEIL_REPOS : mode idle, les timers tournent, réveil par toute interruption. 
+ *            SOMMEIL_ARRET : mode power-down, réveil par INT0 à INT3 seulement 
+ *            (SQW/OUT du DS1307 sur INT2), millis() est corrigé au réveil.
+ */ 
+#define SOMMEIL_REPOS 0
+#define SOMMEIL_ARRET 1
+
+/**
+ *   \brief   Etats comptabilisés
+ */ 
+#define ETAT_ACTIF 0
+#define ETAT_REPOS 1
+#define ETAT_ARRET 2
+#define NB_ETATS   3
+
+/**
+ *   \brief   Courants estimés de l'ATmega32U4 à 16 MHz sous 5 V par état, en µA
+ *
+ *   \details Ordres de grandeur de la documentation, sans les régulateurs et les LED de la carte
+ */ 
+#define COURANT_ACTIF 13000
+#define COURANT_REPOS 5000
+#define COURANT_ARRET 30
+
+/**
+ *   \brief   Courants estimés d'un MAX7219 en µA
+ *
+ *   \details Allumé : moyenne d'un chiffre (environ 1/3 des pixels) à l'intensité maximale,
+ *            proportionnel à l'intensité + 1. Eteint : registre shutdown.
+ */ 
+#define COURANT_MATRICE_MAX     40000
+#define COURANT_MATRICE_ETEINTE 150
+
+/**
+ *   \brief   Période des tops qui réveillent du mode power-down, en ms
+ */ 
+#define PERIODE_TOP 1000
+
+/**
+ *   \brief   Sommeil entre les évènements et bilan de consommation par état
+ */ 
+class Energie {
+	public:
+		Energie(void);
+		
+		void dort(uint8_t);
+		void top(void);
+		void affichage(uint8_t, bool, uint8_t);
+		
+		unsigned long duree(uint8_t);
+		unsigned long dureeAffichage(bool);
+		float charge(void);
+		float courant(void);
+		
+		virtual ~Energie(void);
+		
+	private:
+		void comptabilise(uint8_t, unsigned long);
+		
+		// Durées par état en µs
+		uint64_t durees[NB_ETATS];
+		// Durée matrices allumées, pondérée par intensité + 1, et durée éteintes, en µs
+		uint64_t affichagePondere;
+		uint64_t affichageEteint;
+		
+		// Etat courant des matrices
+		uint8_t nbMatrices;
+		bool allume;
+		uint8_t intensite;
+		
+		// Fin du dernier sommeil en µs
+		unsigned long repere;
+		// Dernier top de seconde en ms, reçu sous interruption
+		volatile unsigned long dernierTop;
+		volatile bool topRecu;
+};
+
+#endif
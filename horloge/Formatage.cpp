@@ -0,0 +1,173 @@
+/*!
+ *   \file    Formatage.cpp
+ *   \brief   Mise en forme des nombres en virgule fixe pour les matrices
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <string.h>
+#include <math.h>
+#include "Chiffres.h"
+#include "Formatage.h"
+
+/**
+ *   \brief   Nombre de chiffres décimaux d'une valeur absolue
+ */ 
+#define NB_CHIFFRES_MAX 8
+
+/**
+ *   \brief   Puissances de 10 pour la conversion en décimal par soustractions
+ */ 
+static const uint32_t puissances[NB_CHIFFRES_MAX] = {
+	10000000UL, 1000000UL, 100000UL, 10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+/**
+ * \brief Essaie de placer les chiffres dans un nombre de cases
+ *
+ * \details Arrondit au plus proche en enlevant des décimales jusqu'à ce que le nombre tienne.
+ *
+ * \param pChiffres les chiffres de la valeur absolue, poids fort en premier
+ * \param pDecimales le nombre de décimales de pChiffres
+ * \param pNegatif true s'il faut la place du signe moins
+ * \param pNbCases le nombre de cases disponibles
+ * \param pDisposition le résultat, rempli à partir de la case 0
+ *
+ * \return true si le nombre tient dans les cases
+ */
+static bool place(const uint8_t *pChiffres, uint8_t pDecimales, bool pNegatif, uint8_t pNbCases, Disposition &pDisposition)
+{
+	for(int8_t decimales = pDecimales; decimales >= 0; decimales--) {
+		// Chiffres gardés, une case de plus pour une retenue éventuelle
+		uint8_t arrondi[NB_CHIFFRES_MAX + 1];
+		uint8_t nbGardes = NB_CHIFFRES_MAX - (pDecimales - decimales);
+		arrondi[0] = 0;
+		memcpy(arrondi + 1, pChiffres, nbGardes);
+		if(nbGardes < NB_CHIFFRES_MAX && pChiffres[nbGardes] >= 5) {
+			int8_t position = nbGardes;
+			while(++arrondi[position] == 10) {
+				arrondi[position--] = 0;
+			}
+		}
+
+		// Premier chiffre significatif, au moins le chiffre des unités
+		uint8_t premier = 0;
+		while(premier < nbGardes - decimales && arrondi[premier] == 0) {
+			premier++;
+		}
+		uint8_t nbChiffres = nbGardes + 1 - premier;
+
+		// Pas de "-0" quand l'arrondi efface tous les chiffres
+		bool negatif = pNegatif;
+		for(uint8_t rang = premier; negatif && rang != nbGardes + 1 && arrondi[rang] == 0; rang++) {
+			negatif = rang != nbGardes;
+		}
+		uint8_t nbUtiles = nbChiffres + (negatif ? 1 : 0);
+		if(nbUtiles > pNbCases) {
+			continue;
+		}
+
+		// Cadrage à droite, cases libres éteintes à gauche
+		uint8_t indice = 0;
+		while(indice < pNbCases - nbUtiles) {
+			pDisposition.cases[indice++] = CAR_VIDE;
+		}
+		if(negatif) {
+			pDisposition.cases[indice++] = CAR_MOINS;
+		}
+		memcpy(pDisposition.cases + indice, arrondi + premier, nbChiffres);
+		pDisposition.virgules = decimales ? CASE(indice + nbChiffres - 1 - decimales) : 0;
+		return(true);
+	}
+	return(false);
+}
+
+/**
+ * \brief Met en forme une valeur en virgule fixe pour 4 matrices
+ *
+ * \details Conversion en décimal sans division, par soustraction des puissances de 10,
+ *          puis arrondi au plus proche sur les chiffres décimaux. 
+ *          Garde le plus de décimales possible, au plus pDecimales. 
+ *          Le suffixe prend la dernière case, il est abandonné si le nombre ne tient 
+ *          pas en 3 cases. Un nombre trop grand même sur 4 cases donne "----".
+ *
+ * \param pValeur la valeur multipliée par 10^pDecimales (ex. 2150 pour 21,50 avec 2 décimales)
+ * \param pDecimales le nombre de décimales de pValeur (au plus DECIMALES_MAX)
+ * \param pSuffixe le symbole de la dernière case (CAR_DEGRE, CAR_POURCENT) ou CAR_VIDE
+ * \param pDisposition la disposition du nombre
+ *
+ * \return false si la valeur ne tient pas dans les matrices
+ */
+bool formate(int32_t pValeur, uint8_t pDecimales, uint8_t pSuffixe, Disposition &pDisposition)
+{
+	if(pDecimales > DECIMALES_MAX) {
+		pDecimales = DECIMALES_MAX;
+	}
+	bool negatif = pValeur < 0;
+	uint32_t reste = negatif ? -(uint32_t)pValeur : (uint32_t)pValeur;
+
+	uint8_t chiffres[NB_CHIFFRES_MAX];
+	bool debordement = reste >= 10 * puissances[0];
+	for(uint8_t rang = 0; rang != NB_CHIFFRES_MAX && !debordement; rang++) {
+		uint8_t chiffre = 0;
+		while(reste >= puissances[rang]) {
+			reste -= puissances[rang];
+			chiffre++;
+		}
+		chiffres[rang] = chiffre;
+	}
+
+	pDisposition.deuxPoints = 0;
+	pDisposition.decalees = 0;
+	if(!debordement) {
+		if(pSuffixe != CAR_VIDE && place(chiffres, pDecimales, negatif, NB_CASES - 1, pDisposition)) {
+			pDisposition.cases[NB_CASES - 1] = pSuffixe;
+			return(true);
+		}
+		if(place(chiffres, pDecimales, negatif, NB_CASES, pDisposition)) {
+			return(true);
+		}
+	}
+
+	indisponible(pDisposition);
+	return(false);
+}
+
+/**
+ * \brief Disposition "----" d'une valeur qui ne peut pas être affichée
+ *
+ * \param pDisposition la disposition
+ */
+void indisponible(Disposition &pDisposition)
+{
+	memset(pDisposition.cases, CAR_MOINS, NB_CASES);
+	pDisposition.virgules = 0;
+	pDisposition.deuxPoints = 0;
+	pDisposition.decalees = 0;
+}
+
+/**
+ * \brief Convertit un réel en virgule fixe pour formate()
+ *
+ * \details Une seule multiplication flottante, arrondi au plus proche. 
+ *          Les valeurs trop grandes pour les matrices sont bornées, elles donnent "----".
+ *
+ * \param pValeur le réel
+ * \param pDecimales le nombre de décimales à garder (au plus DECIMALES_MAX)
+ *
+ * \return pValeur multipliée par 10^pDecimales
+ */
+int32_t virguleFixe(float pValeur, uint8_t pDecimales)
+{
+	static const float echelles[DECIMALES_MAX + 1] = {1.0F, 10.0F, 100.0F, 1000.0F};
+	if(pDecimales > DECIMALES_MAX) {
+		pDecimales = DECIMALES_MAX;
+	}
+	if(pValeur > 99999.0F) {
+		pValeur = 99999.0F;
+	} else if(pValeur < -99999.0F) {
+		pValeur = -99999.0F;
+	}
+	return(lround(pValeur * echelles[pDecimales]));
+}
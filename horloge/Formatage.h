@@ -0,0 +1,48 @@
+/*!
+ *   \file    Formatage.h
+ *   \brief   Entete de la mise en forme des nombres en virgule fixe pour les matrices
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef FORMATAGE_H_
+#define FORMATAGE_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Nombre de cases (matrices) d'un nombre affiché
+ */ 
+#define NB_CASES 4
+
+/**
+ *   \brief   Nombre maximum de décimales d'une valeur
+ */ 
+#define DECIMALES_MAX 3
+
+/**
+ *   \brief   Bit d'une case dans les masques d'une disposition, case 0 à gauche
+ */ 
+#define CASE(indice) (1 << (indice))
+
+/**
+ *   \brief   Disposition des caractères sur les matrices
+ *
+ *   \details cases : codes des caractères de gauche à droite (chiffres, symboles CAR_xxx). 
+ *            virgules : cases avec la virgule (variante VARIANTE_VIRGULE). 
+ *            deuxPoints : cases avec les deux points (variante VARIANTE_DEUX_POINTS). 
+ *            decalees : cases décalées d'un rang (variante VARIANTE_DECALEE).
+ */ 
+struct Disposition {
+	uint8_t cases[NB_CASES];
+	uint8_t virgules;
+	uint8_t deuxPoints;
+	uint8_t decalees;
+};
+
+bool formate(int32_t, uint8_t, uint8_t, Disposition &);
+void indisponible(Disposition &);
+int32_t virguleFixe(float, uint8_t);
+
+#endif
@@ -6,8 +6,9 @@
  *   \date    01/01/2021
  */
 
-#include <SPI.h>
+#include <Arduino.h>
 #include <stdlib.h> 
+#include <string.h>
 #include "Chiffres.h"
 #include "GestionMatrices.h"
 
@@ -18,226 +19,274 @@
  *
  * \note    Initialise le SPI et les MAX7219
  *
+ * \param   pBus Le bus SPI, partagé avec les autres périphériques
  * \param   pCs La broche utilisée pour le CS SPI.
  */
-GestionMatrices::GestionMatrices(uint8_t pCs)
+template<uint8_t N>
+GestionMatrices<N>::GestionMatrices(BusSpi &pBus, uint8_t pCs) : ChaineMatrices(pBus, pCs, N)
 {
-	// Mémorise la broche CS
-	cs = pCs;
+	// Calque vide
+	memset(masques, 0x00, sizeof(masques));
+	memset(valeurs, 0x00, sizeof(valeurs));
+	horlogeAffichee = false;
 	
-	// Gestion broche CS
-	pinMode(cs, OUTPUT);
-
-	// Reverse the SPI transfer to send the MSB first  
-	SPI.setBitOrder(MSBFIRST);
-
-	// Start SPI
-	SPI.begin();
+	// Pas de texte défilant
+	texteDefilant = 0;
+	largeur = 0;
+	colonneCourante = 0;
+	colonnesFinales = 0;
+	
+	// Start SPI, ordre des bits et vitesse réglés à chaque transaction
+	bus.begin(FREQUENCE_SPI);
 
 	reset();
 
 	// Pas de test
-	maxTransfer(0x0F, 0x00, true, true);
-	maxTransfer(0x0F, 0x00, true, true);
-	maxTransfer(0x0F, 0x00, true, true);
-	maxTransfer(0x0F, 0x00, true, true);
+	commande(0x0F, 0x00);
   
 	// Disable mode B
-	maxTransfer(0x09, 0x00, true, true);
+	commande(0x09, 0x00);
 
 	// Init lowest intensity
-	maxTransfer(0x0A, 0x00, true, true);
+	commande(0x0A, 0x00);
 
 	// Scan all digit
-	maxTransfer(0x0B, 0x07, true, true);
+	commande(0x0B, 0x07);
 
 	// Turn on chips
-	maxTransfer(0x0C, 0x01, true, true);
-	maxTransfer(0x0C, 0x01, true, true);
-	maxTransfer(0x0C, 0x01, true, true);
-	maxTransfer(0x0C, 0x01, true, true);
+	commande(0x0C, 0x01);
 }
 
 /**
- * \brief   Réglage de l'intensité. 
+ * \brief Donne le code d'une ligne d'une matrice pour l'affichage d'un caractère
+ *
+ * \details Lecture dans les tables en flash générées depuis polices/chiffres.txt.
+ *          Un code inconnu donne une matrice éteinte.
  *
- * \param   pIntensity L'intensité.
+ * \param pVariante la variante du chiffre (VARIANTE_xxx), ignorée pour les symboles
+ * \param pCode le chiffre à afficher (0 à 9) ou le symbole (CAR_xxx)
+ * \param pLigne la ligne du caractère
  *
- * \attention intensité entre 0x00 et 0x0F
+ * \return renvoi l'octet correspondant au segment à afficher
  */
-void GestionMatrices::intensity(uint8_t pIntensity)
+template<uint8_t N>
+uint8_t GestionMatrices<N>::glyphe(uint8_t pVariante, uint8_t pCode, uint8_t pLigne)
 {
-	maxTransfer(0x0A, pIntensity, true, false);
-	maxTransfer(0x0A, pIntensity, false, false);
-	maxTransfer(0x0A, pIntensity, false, false);
-	maxTransfer(0x0A, pIntensity, false, true);
+	return(ligneGlyphe(pVariante, pCode, pLigne));
 }
 
 /**
- * \brief Donne le code d'une ligne d'une matrice pour l'affichage du degré
+ * \brief Eteint toutes les matrices
  *
- * \param pLigne la ligne du degré  
+ */
+template<uint8_t N>
+void GestionMatrices<N>::reset(void)
+{
+	// Disable mode B
+	commande(0x09, 0x00);
+	// Blank sur les 8 lignes
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		commande(ligne + 1, 0x00);
+	}
+
+	// Les registres et l'image sont maintenant vides
+	memset(image, 0x00, sizeof(image));
+	memset(registres, 0x00, sizeof(registres));
+}
+
+/**
+ * \brief Convertit l'image dans l'orientation des MAX7219
  *
- * \return renvoi l'octet correspondant au segment à afficher
+ * \details Rien à faire avec ORIENTATION_NORMALE. Sinon chaque module est converti
+ *          (transposition 8x8 et miroirs, voir Orientation.h) avant la comparaison aux registres.
  */
-uint8_t GestionMatrices::segmentDeg(uint8_t pLigne)
+template<uint8_t N>
+void GestionMatrices<N>::oriente(void)
 {
-	return(degre[pLigne]);
+#if ORIENTATION_MATRICES != ORIENTATION_NORMALE
+	for(uint8_t module = 0; module != N; module++) {
+		orienteModule(&image[0][module], &materiel[0][module], N);
+	}
+#endif
 }
 
 /**
- * \brief Donne le code d'une ligne d'une matrice pour l'affichage du poucent
+ * \brief Valeurs d'un registre ligne pour toute la chaine
  *
- * \param pLigne la ligne du pourcent  
+ * \param pLigne le registre 0x01 + pLigne
  *
- * \return renvoi l'octet correspondant au segment à afficher
+ * \return les valeurs, module 0 à gauche : la ligne de l'image ou de l'image convertie
  */
-uint8_t GestionMatrices::segmentPourcent(uint8_t pLigne)
+template<uint8_t N>
+const uint8_t *GestionMatrices<N>::sortie(uint8_t pLigne)
 {
-	return(pourcent[pLigne]);
+#if ORIENTATION_MATRICES != ORIENTATION_NORMALE
+	return(materiel[pLigne]);
+#else
+	return(image[pLigne]);
+#endif
 }
 
 /**
- * \brief Donne le code d'une ligne d'une matrice pour l'affichage d'un chiffre
+ * \brief Envoie aux matrices les lignes de l'image qui ont changé
  *
- * \param pValeur le chiffre à afficher
- * \param pLigne la ligne du chiffre  
+ * \details Compare l'image à la copie des registres des MAX7219 (lignesModifiees()) et
+ *          n'envoie que les lignes dont au moins un octet diffère.
+ */
+template<uint8_t N>
+void GestionMatrices<N>::flush(void)
+{
+	uint8_t modifiees = lignesModifiees();
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		if(modifiees & (1 << ligne)) {
+			envoiLigne(ligne);
+		}
+	}
+}
+
+/**
+ * \brief Applique l'image aux matrices sans mélange de l'ancienne et de la nouvelle
  *
- * \return renvoi l'octet correspondant au segment à afficher
+ * \details Voir ChaineMatrices::applique(), la chaine étant seule.
+ *          Sans effet si la chaine est différée : l'Afficheur l'appliquera avec les autres.
+ *          Seul un nouveau dessin (horloge, affichage) est appliqué derrière une extinction,
+ *          pas les images du défilement. La durée de la salve est donnée par latence().
  */
-uint8_t GestionMatrices::segment(uint8_t pValeur, uint8_t pLigne)
+template<uint8_t N>
+void GestionMatrices<N>::commit(void)
 {
-	switch(pValeur) {
-		case 0: return(zero[pLigne]);
-		case 1: return(un[pLigne]);
-		case 2: return(deux[pLigne]);
-		case 3: return(trois[pLigne]);
-		case 4: return(quatre[pLigne]);
-		case 5: return(cinq[pLigne]);
-		case 6: return(six[pLigne]);
-		case 7: return(sept[pLigne]);
-		case 8: return(huit[pLigne]);
-		case 9: return(neuf[pLigne]);
+	if(differee) {
+		return;
 	}
+	ChaineMatrices *chaine = this;
+	applique(&chaine, 1);
 }
 
 /**
- * \brief Donne le code d'une ligne d'une matrice pour l'affichage d'un chiffre avec deux points
+ * \brief Lignes de l'image qui diffèrent des registres des MAX7219
  *
- * \param pValeur le chiffre à afficher
- * \param pLigne la ligne du chiffre  
+ * \details L'image est d'abord convertie dans l'orientation des MAX7219
  *
- * \return renvoi l'octet correspondant au segment à afficher
+ * \return un bit par registre ligne, bit 0 = registre 0x01
  */
-uint8_t GestionMatrices::segmentDp(uint8_t pValeur, uint8_t pLigne)
+template<uint8_t N>
+uint8_t GestionMatrices<N>::lignesModifiees(void)
 {
-	switch(pValeur) {
-		case 0: return(zeroDp[pLigne]);
-		case 1: return(unDp[pLigne]);
-		case 2: return(deuxDp[pLigne]);
-		case 3: return(troisDp[pLigne]);
-		case 4: return(quatreDp[pLigne]);
-		case 5: return(cinqDp[pLigne]);
-		case 6: return(sixDp[pLigne]);
-		case 7: return(septDp[pLigne]);
-		case 8: return(huitDp[pLigne]);
-		case 9: return(neufDp[pLigne]);
+	oriente();
+	uint8_t modifiees = 0;
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		if(memcmp(sortie(ligne), registres[ligne], N) != 0) {
+			modifiees |= 1 << ligne;
+		}
 	}
+	return(modifiees);
 }
 
 /**
- * \brief Donne le code d'une ligne d'une matrice pour l'affichage d'un chiffre avec un décalage d'un rang
+ * \brief Durée du dernier commit
  *
- * \param pValeur le chiffre à afficher
- * \param pLigne la ligne du chiffre  
+ * \details Attend la fin de la salve en cours, le commit étant mis en file d'un bloc 
+ *          et envoyé par l'interruption : c'est la durée d'extinction d'un nouveau dessin.
  *
- * \return renvoi l'octet correspondant au segment à afficher
+ * \return la durée en µs
+ */
+template<uint8_t N>
+unsigned long GestionMatrices<N>::latence(void)
+{
+	bus.attente();
+	return(bus.duree());
+}
+
+/**
+ * \brief Renvoie toute l'image aux matrices
+ *
+ * \details Ignore la copie des registres, permet de récupérer un affichage
+ *          perturbé (parasite, matrice rebranchée...)
  */
-uint8_t GestionMatrices::segmentDm(uint8_t pValeur, uint8_t pLigne)
+template<uint8_t N>
+void GestionMatrices<N>::forceRefresh(void)
 {
-	switch(pValeur) {
-		case 0: return(zeroDm[pLigne]);
-		case 1: return(unDm[pLigne]);
-		case 2: return(deuxDm[pLigne]);
-		case 3: return(troisDm[pLigne]);
-		case 4: return(quatreDm[pLigne]);
-		case 5: return(cinqDm[pLigne]);
-		case 6: return(sixDm[pLigne]);
-		case 7: return(septDm[pLigne]);
-		case 8: return(huitDm[pLigne]);
-		case 9: return(neufDm[pLigne]);
+	oriente();
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		envoiLigne(ligne);
 	}
 }
 
 /**
- * \brief Donne le code d'une ligne d'une matrice pour l'affichage d'un chiffre avec virgule
+ * \brief Envoie une ligne de l'image à toutes les matrices
  *
- * \param pValeur le chiffre à afficher
- * \param pLigne la ligne du chiffre  
+ * \details Le premier octet envoyé aboutit dans le dernier module de la chaine,
+ *          l'envoi commence donc par la matrice la plus loin de l'Arduino (ORDRE_MODULES).
  *
- * \return renvoi l'octet correspondant au segment à afficher
+ * \param pLigne le registre ligne à envoyer (entre 0 et 7), de l'image convertie par oriente()
  */
-uint8_t GestionMatrices::segmentV(uint8_t pValeur, uint8_t pLigne)
+template<uint8_t N>
+void GestionMatrices<N>::envoiLigne(uint8_t pLigne)
 {
-	switch(pValeur) {
-		case 0: return(zeroV[pLigne]);
-		case 1: return(unV[pLigne]);
-		case 2: return(deuxV[pLigne]);
-		case 3: return(troisV[pLigne]);
-		case 4: return(quatreV[pLigne]);
-		case 5: return(cinqV[pLigne]);
-		case 6: return(sixV[pLigne]);
-		case 7: return(septV[pLigne]);
-		case 8: return(huitV[pLigne]);
-		case 9: return(neufV[pLigne]);
+	const uint8_t *valeursLigne = sortie(pLigne);
+	uint8_t *octet = tampon;
+	for(uint8_t rang = 0; rang != N; rang++) {
+		uint8_t module = moduleEmis(rang, N);
+		*octet++ = pLigne + 1;
+		*octet++ = valeursLigne[module];
+		registres[pLigne][module] = valeursLigne[module];
 	}
+	transfert();
 }
 
 /**
- * \brief Eteint toutes les matrices
+ * \brief Envoie un registre ligne à une seule matrice
  *
+ * \details Les autres matrices reçoivent un no-op (registre 0x00) et gardent leur ligne.
+ *
+ * \param pLigne le registre ligne à envoyer (entre 0 et 7), de l'image convertie
+ * \param pModule la matrice, 0 à gauche
  */
-void GestionMatrices::reset(void)
+template<uint8_t N>
+void GestionMatrices<N>::envoiRegistre(uint8_t pLigne, uint8_t pModule)
 {
- 	// Enable mode B
-	maxTransfer(0x09, 0x00, true, true);
-	// Blank sur les 8 lignes
-	maxTransfer(0x01, 0x00, true, true);
-	maxTransfer(0x02, 0x00, true, true);
-	maxTransfer(0x03, 0x00, true, true);
-	maxTransfer(0x04, 0x00, true, true);
-	maxTransfer(0x05, 0x00, true, true);
-	maxTransfer(0x06, 0x00, true, true);
-	maxTransfer(0x07, 0x00, true, true);
-	maxTransfer(0x08, 0x00, true, true);
-	// Derniers décalages aux trois derniers modules
-	maxTransfer(0x00, 0x00, true, true);
-	maxTransfer(0x00, 0x00, true, true);
-	maxTransfer(0x00, 0x00, true, true);
+	uint8_t valeur = sortie(pLigne)[pModule];
+	uint8_t *octet = tampon;
+	for(uint8_t rang = 0; rang != N; rang++) {
+		if(moduleEmis(rang, N) == pModule) {
+			*octet++ = pLigne + 1;
+			*octet++ = valeur;
+		} else {
+			*octet++ = 0x00;
+			*octet++ = 0x00;
+		}
+	}
+	registres[pLigne][pModule] = valeur;
+	transfert();
 }
 
 /**
- * \brief Transfert une valeur vers un registre du MAX7219
- *
- * \details Gère aussi la broche CS pour pouvoir coupler des commandes
+ * \brief Envoie la même commande à toutes les matrices de la chaine
  *
  * \param pAddress registre du MAX7219
  * \param pValue valeur à transférer 
- * \param pValue valeur à transférer 
- * \param pValue valeur à transférer 
  */
-void GestionMatrices::maxTransfer(uint8_t pAddress, uint8_t pValue, bool pLow, bool pUp)
+template<uint8_t N>
+void GestionMatrices<N>::commande(uint8_t pAddress, uint8_t pValue)
 {
-	if(pLow) {
-		digitalWrite(cs, LOW);
+	uint8_t *octet = tampon;
+	for(uint8_t module = 0; module != N; module++) {
+		*octet++ = pAddress;
+		*octet++ = pValue;
 	}
+	transfert();
+}
 
-	SPI.transfer(pAddress);
-	SPI.transfer(pValue);
-
-	if(pUp) {
-		digitalWrite(cs, HIGH);
-	}
+/**
+ * \brief Transfert le tampon vers les registres des MAX7219
+ *
+ * \details Une seule trame, donc une seule fenêtre CS, pour toute la chaine.
+ *          Le tampon est copié dans la file du bus, il est aussitôt réutilisable.
+ */
+template<uint8_t N>
+void GestionMatrices<N>::transfert(void)
+{
+	bus.envoi(cs, tampon, sizeof(tampon));
 }
 
 /**
@@ -245,875 +294,394 @@ void GestionMatrices::maxTransfer(uint8_t pAddress, uint8_t pValue, bool pLow, b
  *
  * \param pTm structure tm jour et heure
 */
-void GestionMatrices::horloge(tmElements_t pTm)
+template<uint8_t N>
+void GestionMatrices<N>::horloge(tmElements_t pTm)
 {
+	Disposition disposition;
 	// Dizaine d'heures
-	uint8_t nbDizaineHeure = pTm.Hour / 10;
-	// Heures
-	uint8_t nbHeure = pTm.Hour % 10;
-	// Dizaine de minutes
-	uint8_t nbDizaineMinute = pTm.Minute / 10;
+	disposition.cases[0] = pTm.Hour / 10;
+	// Heures, avec les deux points
+	disposition.cases[1] = pTm.Hour % 10;
+	// Dizaine de minutes, décalée d'un rang pour laisser la place aux deux points
+	disposition.cases[2] = pTm.Minute / 10;
 	// Minutes
-	uint8_t nbMinute = pTm.Minute % 10;
-
-	heure(nbDizaineHeure, nbHeure, nbDizaineMinute, nbMinute); 
+	disposition.cases[3] = pTm.Minute % 10;
+	disposition.virgules = 0;
+	disposition.deuxPoints = CASE(1);
+	disposition.decalees = CASE(2);
+
+	dessine(disposition);
+	// Calque des deux points et des secondes
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		for(uint8_t module = 0; module != N; module++) {
+			image[ligne][module] = (image[ligne][module] & ~masques[ligne][module]) | valeurs[ligne][module];
+		}
+	}
+	horlogeAffichee = true;
+	redessine = true;
+	commit();
 }
 
 /**
- * \brief Affichage d'un nombre réel
+ * \brief Allume ou éteint les deux points de l'horloge
  *
- * \param pValeur la valeur à afficher
+ * \details Par le calque : au plus 2 registres d'une seule matrice sont envoyés
+ *
+ * \param pAllume true pour allumer
  */
-void GestionMatrices::affichage(float pValeur)
+template<uint8_t N>
+void GestionMatrices<N>::deuxPoints(bool pAllume)
 {
-	uint8_t unites;
-	uint8_t dizaines;
-	uint8_t centaines;
-	uint8_t milliers;
-	uint8_t diziemes;
-	uint8_t centiemes;
-	uint8_t milliemes;
-	if(pValeur >= 1000.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		centaines = ((int)pValeur % 1000) / 100;
-		milliers = (int)pValeur / 1000;
-		millier(milliers, centaines, dizaines, unites); 
-	} else if(pValeur >= 100.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		centaines = ((int)pValeur % 1000) / 100;
-		diziemes = ((int)(pValeur * 10)) % 10;
-		centaine( centaines, dizaines, unites, diziemes); 		
-	} else if(pValeur >= 10.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		diziemes = ((int)(pValeur * 10)) % 10;
-		centiemes = ((int)(pValeur * 100)) % 10;
-		dizaine(dizaines, unites, diziemes, centiemes); 		
-	} else {
-		unites = (int)pValeur % 10;
-		diziemes = ((int)(pValeur * 10)) % 10;
-		centiemes = ((int)(pValeur * 100)) % 10;
-		milliemes = ((int)(pValeur * 1000)) % 10;
-		unite(unites, diziemes, centiemes, milliemes); 		
-	}
+	uint8_t valeur = pAllume ? MASQUE_DEUX_POINTS : 0x00;
+	calque(MODULE_DEUX_POINTS, LIGNE_DEUX_POINTS_1, MASQUE_DEUX_POINTS, valeur);
+	calque(MODULE_DEUX_POINTS, LIGNE_DEUX_POINTS_2, MASQUE_DEUX_POINTS, valeur);
 }
 
 /**
- * \brief Affichage d'un nombre réel avec degré
+ * \brief Barre des secondes de l'horloge
  *
- * \param pValeur la valeur à afficher
+ * \details Un pixel de plus toutes les 7,5 s, du bas vers le haut.
+ *          Par le calque : seuls les registres qui changent sont envoyés, 
+ *          un seul par tranche de 7,5 s.
+ *
+ * \param pSeconde la seconde (0 à 59)
  */
-void GestionMatrices::affichageDeg(float pValeur)
+template<uint8_t N>
+void GestionMatrices<N>::secondes(uint8_t pSeconde)
 {
-	uint8_t unites;
-	uint8_t dizaines;
-	uint8_t centaines;
-	uint8_t milliers;
-	uint8_t diziemes;
-	uint8_t centiemes;
-	if(pValeur >= 1000.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		centaines = ((int)pValeur % 1000) / 100;
-		milliers = (int)pValeur / 1000;
-		millier(milliers, centaines, dizaines, unites); 
-	} else if(pValeur >= 100.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		centaines = ((int)pValeur % 1000) / 100;
-		centaineDeg( centaines, dizaines, unites); 		
-	} else if(pValeur >= 10.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		diziemes = ((int)(pValeur * 10)) % 10;
-		dizaineDeg(dizaines, unites, diziemes); 		
-	} else {
-		unites = (int)pValeur % 10;
-		diziemes = ((int)(pValeur * 10)) % 10;
-		centiemes = ((int)(pValeur * 100)) % 10;
-		uniteDeg(unites, diziemes, centiemes); 		
+	uint8_t allumes = pSeconde * NB_LIGNES / 60;
+	for(uint8_t rang = 0; rang != NB_LIGNES; rang++) {
+		calque(MODULE_SECONDES, NB_LIGNES - 1 - rang, MASQUE_SECONDES, rang < allumes ? MASQUE_SECONDES : 0x00);
 	}
 }
 
 /**
- * \brief Affichage d'un nombre réel avec pourcent
+ * \brief Indicateur de baisse de la pression sur l'horloge
  *
- * \param pValeur la valeur à afficher
+ * \details Par le calque : 3 registres de la matrice de gauche au plus, 
+ *          seulement quand l'indicateur change.
+ *
+ * \param pBaisse true pour allumer l'indicateur
  */
-void GestionMatrices::affichagePourcent(float pValeur)
+template<uint8_t N>
+void GestionMatrices<N>::baisse(bool pBaisse)
 {
-	uint8_t unites;
-	uint8_t dizaines;
-	uint8_t centaines;
-	uint8_t milliers;
-	uint8_t diziemes;
-	uint8_t centiemes;
-	if(pValeur >= 1000.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		centaines = ((int)pValeur % 1000) / 100;
-		milliers = (int)pValeur / 1000;
-		millier(milliers, centaines, dizaines, unites); 
-	} else if(pValeur >= 100.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		centaines = ((int)pValeur % 1000) / 100;
-		centainePourcent( centaines, dizaines, unites); 		
-	} else if(pValeur >= 10.0F) {
-		unites = (int)pValeur % 10;
-		dizaines = ((int)pValeur % 100) / 10;
-		diziemes = ((int)(pValeur * 10)) % 10;
-		dizainePourcent(dizaines, unites, diziemes); 		
-	} else {
-		unites = (int)pValeur % 10;
-		diziemes = ((int)(pValeur * 10)) % 10;
-		centiemes = ((int)(pValeur * 100)) % 10;
-		unitePourcent(unites, diziemes, centiemes); 		
+	for(uint8_t ligne = LIGNE_BAISSE; ligne != NB_LIGNES; ligne++) {
+		calque(MODULE_BAISSE, ligne, MASQUE_BAISSE, pBaisse ? MASQUE_BAISSE : 0x00);
 	}
 }
 
 /**
- * \brief   Affichage de l'heure. 
- *
- * \details Affichage des chiffres sur les 8 segments des 4 matrices
- *
- * \param   pNbDizaineHeure Les dizaines d'heures (entre 0 et 2)
- * \param   pNbHeure Les heures (entre 0 et 9 ou entre 0 et 3 si les dizaines d'heures sont à 2)
- * \param   pNbDizaineMinute Les dizaines de minute (entre 0 et 5)
- * \param   pNbMinute Les minutes (entre 0 et 9)
+ * \brief Impose des pixels de l'horloge
+ *
+ * \details Les pixels du masque gardent leur valeur par dessus les chiffres
+ *          jusqu'à effaceCalque(). Si l'horloge est affichée et que la ligne change, 
+ *          seul le registre de cette ligne de cette matrice est envoyé
+ *          (de la colonne si les matrices sont transposées).
+ *          Une chaine différée ne fait que modifier l'image, envoyée par l'Afficheur.
+ *
+ * \param pModule la matrice, 0 à gauche
+ * \param pLigne la ligne (entre 0 et 7)
+ * \param pMasque les pixels imposés
+ * \param pValeur leur état
  */
-void GestionMatrices::heure(uint8_t pNbDizaineHeure, uint8_t pNbHeure, uint8_t pNbDizaineMinute, uint8_t pNbMinute) 
+template<uint8_t N>
+void GestionMatrices<N>::calque(uint8_t pModule, uint8_t pLigne, uint8_t pMasque, uint8_t pValeur)
 {
-	// Affichage des chiffres sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segment(pNbMinute, compteur), true, false);
-			maxTransfer(0x01, segmentDm(pNbDizaineMinute, compteur), false, false);
-			maxTransfer(0x01, segmentDp(pNbHeure, compteur), false, false);
-			maxTransfer(0x01, segment(pNbDizaineHeure, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segment(pNbMinute, compteur), true, false);
-			maxTransfer(0x02, segmentDm(pNbDizaineMinute, compteur), false, false);
-			maxTransfer(0x02, segmentDp(pNbHeure, compteur), false, false);
-			maxTransfer(0x02, segment(pNbDizaineHeure, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segment(pNbMinute, compteur), true, false);
-			maxTransfer(0x03, segmentDm(pNbDizaineMinute, compteur), false, false);
-			maxTransfer(0x03, segmentDp(pNbHeure, compteur), false, false);
-			maxTransfer(0x03, segment(pNbDizaineHeure, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segment(pNbMinute, compteur), true, false);
-			maxTransfer(0x04, segmentDm(pNbDizaineMinute, compteur), false, false);
-			maxTransfer(0x04, segmentDp(pNbHeure, compteur), false, false);
-			maxTransfer(0x04, segment(pNbDizaineHeure, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segment(pNbMinute, compteur), true, false);
-			maxTransfer(0x05, segmentDm(pNbDizaineMinute, compteur), false, false);
-			maxTransfer(0x05, segmentDp(pNbHeure, compteur), false, false);
-			maxTransfer(0x05, segment(pNbDizaineHeure, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segment(pNbMinute, compteur), true, false);
-			maxTransfer(0x06, segmentDm(pNbDizaineMinute, compteur), false, false);
-			maxTransfer(0x06, segmentDp(pNbHeure, compteur), false, false);
-			maxTransfer(0x06, segment(pNbDizaineHeure, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segment(pNbMinute, compteur), true, false);
-			maxTransfer(0x07, segmentDm(pNbDizaineMinute, compteur), false, false);
-			maxTransfer(0x07, segmentDp(pNbHeure, compteur), false, false);
-			maxTransfer(0x07, segment(pNbDizaineHeure, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segment(pNbMinute, compteur), true, false);
-			maxTransfer(0x08, segmentDm(pNbDizaineMinute, compteur), false, false);
-			maxTransfer(0x08, segmentDp(pNbHeure, compteur), false, false);
-			maxTransfer(0x08, segment(pNbDizaineHeure, compteur), false, true);
-			break;
+	masques[pLigne][pModule] |= pMasque;
+	valeurs[pLigne][pModule] = (valeurs[pLigne][pModule] & ~pMasque) | (pValeur & pMasque);
+	if(!horlogeAffichee) {
+		return;
+	}
+	uint8_t avant = image[pLigne][pModule];
+	image[pLigne][pModule] = (avant & ~pMasque) | (pValeur & pMasque);
+	// La ligne diffère maintenant des registres, le prochain commit de l'Afficheur l'enverra
+	if(differee) {
+		return;
+	}
+#if ORIENTATION_MATRICES != ORIENTATION_NORMALE
+	// Pixels inchangés : pas de conversion du module
+	if(image[pLigne][pModule] == avant) {
+		return;
+	}
+	orienteModule(&image[0][pModule], &materiel[0][pModule], N);
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		if(materiel[ligne][pModule] != registres[ligne][pModule]) {
+			envoiRegistre(ligne, pModule);
 		}
 	}
+#else
+	if(image[pLigne][pModule] != registres[pLigne][pModule]) {
+		envoiRegistre(pLigne, pModule);
+	}
+#endif
 }
 
 /**
- * \brief   Affichage d'un nombre sans virgule. 
- *
- * \details Affichage des chiffres sur les 8 segments des 4 matrices
+ * \brief Libère tous les pixels du calque
  *
- * \param   pMillier
- * \param   pCentaine
- * \param   pDizaine
- * \param   pUnite
+ * \details Ils reprennent le dessin des chiffres au prochain affichage de l'horloge
  */
-void GestionMatrices::millier(uint8_t pMillier, uint8_t pCentaine, uint8_t pDizaine, uint8_t pUnite) 
+template<uint8_t N>
+void GestionMatrices<N>::effaceCalque(void)
 {
-	// Affichage des chiffres sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segment(pUnite, compteur), true, false);
-			maxTransfer(0x01, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x01, segment(pCentaine, compteur), false, false);
-			maxTransfer(0x01, segment(pMillier, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segment(pUnite, compteur), true, false);
-			maxTransfer(0x02, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x02, segment(pCentaine, compteur), false, false);
-			maxTransfer(0x02, segment(pMillier, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segment(pUnite, compteur), true, false);
-			maxTransfer(0x03, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x03, segment(pCentaine, compteur), false, false);
-			maxTransfer(0x03, segment(pMillier, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segment(pUnite, compteur), true, false);
-			maxTransfer(0x04, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x04, segment(pCentaine, compteur), false, false);
-			maxTransfer(0x04, segment(pMillier, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segment(pUnite, compteur), true, false);
-			maxTransfer(0x05, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x05, segment(pCentaine, compteur), false, false);
-			maxTransfer(0x05, segment(pMillier, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segment(pUnite, compteur), true, false);
-			maxTransfer(0x06, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x06, segment(pCentaine, compteur), false, false);
-			maxTransfer(0x06, segment(pMillier, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segment(pUnite, compteur), true, false);
-			maxTransfer(0x07, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x07, segment(pCentaine, compteur), false, false);
-			maxTransfer(0x07, segment(pMillier, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segment(pUnite, compteur), true, false);
-			maxTransfer(0x08, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x08, segment(pCentaine, compteur), false, false);
-			maxTransfer(0x08, segment(pMillier, compteur), false, true);
-			break;
-		}
-	}
+	memset(masques, 0x00, sizeof(masques));
+	memset(valeurs, 0x00, sizeof(valeurs));
 }
 
 /**
- * \brief   Affichage d'un nombre avec un chiffre après la virgule. 
+ * \brief Affichage d'un nombre réel
  *
- * \details Affichage des chiffres sur les 8 segments des 4 matrices
+ * \details Jusqu'à 3 décimales, arrondi au plus proche
  *
- * \param   pCentaine
- * \param   pDizaine
- * \param   pUnite
- * \param   pDizieme
+ * \param pValeur la valeur à afficher
  */
-void GestionMatrices::centaine(uint8_t pCentaine, uint8_t pDizaine, uint8_t pUnite, uint8_t pDizieme) 
+template<uint8_t N>
+void GestionMatrices<N>::affichage(float pValeur)
 {
-	// Affichage des chiffres sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segment(pDizieme, compteur), true, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x01, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x01, segment(pCentaine, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segment(pDizieme, compteur), true, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x02, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x02, segment(pCentaine, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segment(pDizieme, compteur), true, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x03, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x03, segment(pCentaine, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segment(pDizieme, compteur), true, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x04, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x04, segment(pCentaine, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segment(pDizieme, compteur), true, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x05, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x05, segment(pCentaine, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segment(pDizieme, compteur), true, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x06, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x06, segment(pCentaine, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segment(pDizieme, compteur), true, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x07, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x07, segment(pCentaine, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segment(pDizieme, compteur), true, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x08, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x08, segment(pCentaine, compteur), false, true);
-			break;
-		}
-	}
+	affichage(virguleFixe(pValeur, 3), 3, CAR_VIDE);
 }
 
 /**
- * \brief   Affichage d'un nombre avec degré. 
+ * \brief Affichage d'un nombre réel avec degré
  *
- * \details Affichage des chiffres sur les 8 segments des 3 matrices et degré à la fin
+ * \details Jusqu'à 2 décimales, arrondi au plus proche
  *
- * \param   pCentaine
- * \param   pDizaine
- * \param   pUnite
+ * \param pValeur la valeur à afficher
  */
-void GestionMatrices::centaineDeg(uint8_t pCentaine, uint8_t pDizaine, uint8_t pUnite) 
+template<uint8_t N>
+void GestionMatrices<N>::affichageDeg(float pValeur)
 {
-	// Affichage des caractères sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segmentDeg(compteur), true, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x01, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x01, segment(pCentaine, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segmentDeg(compteur), true, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x02, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x02, segment(pCentaine, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segmentDeg(compteur), true, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x03, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x03, segment(pCentaine, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segmentDeg(compteur), true, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x04, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x04, segment(pCentaine, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segmentDeg(compteur), true, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x05, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x05, segment(pCentaine, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segmentDeg(compteur), true, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x06, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x06, segment(pCentaine, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segmentDeg(compteur), true, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x07, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x07, segment(pCentaine, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segmentDeg(compteur), true, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x08, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x08, segment(pCentaine, compteur), false, true);
-			break;
-		}
-	}
+	affichage(virguleFixe(pValeur, 2), 2, CAR_DEGRE);
 }
 
 /**
- * \brief   Affichage d'un nombre avec pourcent. 
+ * \brief Affichage d'un nombre réel avec pourcent
  *
- * \details Affichage des chiffres sur les 8 segments des 3 matrices et pourcent à la fin
+ * \details Jusqu'à 2 décimales, arrondi au plus proche
  *
- * \param   pCentaine
- * \param   pDizaine
- * \param   pUnite
+ * \param pValeur la valeur à afficher
  */
-void GestionMatrices::centainePourcent(uint8_t pCentaine, uint8_t pDizaine, uint8_t pUnite) 
+template<uint8_t N>
+void GestionMatrices<N>::affichagePourcent(float pValeur)
 {
-	// Affichage des caractères sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segmentPourcent(compteur), true, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x01, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x01, segment(pCentaine, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segmentPourcent(compteur), true, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x02, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x02, segment(pCentaine, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segmentPourcent(compteur), true, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x03, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x03, segment(pCentaine, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segmentPourcent(compteur), true, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x04, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x04, segment(pCentaine, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segmentPourcent(compteur), true, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x05, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x05, segment(pCentaine, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segmentPourcent(compteur), true, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x06, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x06, segment(pCentaine, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segmentPourcent(compteur), true, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x07, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x07, segment(pCentaine, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segmentPourcent(compteur), true, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x08, segment(pDizaine, compteur), false, false);
-			maxTransfer(0x08, segment(pCentaine, compteur), false, true);
-			break;
-		}
-	}
+	affichage(virguleFixe(pValeur, 2), 2, CAR_POURCENT);
 }
 
 /**
- * \brief   Affichage d'un nombre avec deux chiffres après la virgule. 
+ * \brief Affichage d'un nombre en virgule fixe
  *
- * \details Affichage des chiffres sur les 8 segments des 4 matrices
+ * \details Garde le plus de décimales possible avec un arrondi au plus proche.
+ *          Les nombres négatifs commencent par un moins, 
+ *          un nombre qui ne tient pas dans les matrices s'affiche "----".
  *
- * \param   pDizaine
- * \param   pUnite
- * \param   pDizieme
- * \param   pCentieme
+ * \param pValeur la valeur multipliée par 10^pDecimales (ex. 10132 pour 1013,2 hPa avec 1 décimale)
+ * \param pDecimales le nombre de décimales de pValeur (au plus 3)
+ * \param pSuffixe CAR_DEGRE, CAR_POURCENT ou CAR_VIDE pour un nombre seul
  */
-void GestionMatrices::dizaine(uint8_t pDizaine, uint8_t pUnite, uint8_t pDizieme, uint8_t pCentieme) 
+template<uint8_t N>
+void GestionMatrices<N>::affichage(int32_t pValeur, uint8_t pDecimales, uint8_t pSuffixe)
 {
-	// Affichage des chiffres sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segment(pCentieme, compteur), true, false);
-			maxTransfer(0x01, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x01, segment(pDizaine, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segment(pCentieme, compteur), true, false);
-			maxTransfer(0x02, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x02, segment(pDizaine, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segment(pCentieme, compteur), true, false);
-			maxTransfer(0x03, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x03, segment(pDizaine, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segment(pCentieme, compteur), true, false);
-			maxTransfer(0x04, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x04, segment(pDizaine, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segment(pCentieme, compteur), true, false);
-			maxTransfer(0x05, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x05, segment(pDizaine, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segment(pCentieme, compteur), true, false);
-			maxTransfer(0x06, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x06, segment(pDizaine, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segment(pCentieme, compteur), true, false);
-			maxTransfer(0x07, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x07, segment(pDizaine, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segment(pCentieme, compteur), true, false);
-			maxTransfer(0x08, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x08, segment(pDizaine, compteur), false, true);
-			break;
-		}
-	}
+	Disposition disposition;
+	formate(pValeur, pDecimales, pSuffixe, disposition);
+	affichage(disposition);
 }
 
 /**
- * \brief   Affichage d'un nombre avec un chiffres après la virgule et degré. 
+ * \brief   Affichage d'une disposition de caractères. 
  *
- * \details Affichage des chiffres sur les 8 segments des 3 matrices et degré à la fin
+ * \details Une case par matrice en partant de la gauche, 
+ *          la variante de chaque case est donnée par les masques de la disposition.
+ *          Les matrices au-delà de la 4ème ne sont pas modifiées.
  *
- * \param   pDizaine
- * \param   pUnite
- * \param   pDizieme
+ * \param   pDisposition les caractères et leurs variantes
  */
-void GestionMatrices::dizaineDeg(uint8_t pDizaine, uint8_t pUnite, uint8_t pDizieme) 
+template<uint8_t N>
+void GestionMatrices<N>::affichage(const Disposition &pDisposition) 
 {
-	// Affichage des caractères sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segmentDeg(compteur), true, false);
-			maxTransfer(0x01, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x01, segment(pDizaine, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segmentDeg(compteur), true, false);
-			maxTransfer(0x02, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x02, segment(pDizaine, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segmentDeg(compteur), true, false);
-			maxTransfer(0x03, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x03, segment(pDizaine, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segmentDeg(compteur), true, false);
-			maxTransfer(0x04, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x04, segment(pDizaine, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segmentDeg(compteur), true, false);
-			maxTransfer(0x05, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x05, segment(pDizaine, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segmentDeg(compteur), true, false);
-			maxTransfer(0x06, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x06, segment(pDizaine, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segmentDeg(compteur), true, false);
-			maxTransfer(0x07, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x07, segment(pDizaine, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segmentDeg(compteur), true, false);
-			maxTransfer(0x08, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x08, segment(pDizaine, compteur), false, true);
-			break;
+	horlogeAffichee = false;
+	dessine(pDisposition);
+	redessine = true;
+	commit();
+}
+
+/**
+ * \brief   Dessine une disposition de caractères dans l'image
+ *
+ * \param   pDisposition les caractères et leurs variantes
+ */
+template<uint8_t N>
+void GestionMatrices<N>::dessine(const Disposition &pDisposition) 
+{
+	uint8_t variantes[NB_CASES];
+	for(uint8_t indice = 0; indice != NB_CASES; indice++) {
+		if(pDisposition.virgules & CASE(indice)) {
+			variantes[indice] = VARIANTE_VIRGULE;
+		} else if(pDisposition.deuxPoints & CASE(indice)) {
+			variantes[indice] = VARIANTE_DEUX_POINTS;
+		} else if(pDisposition.decalees & CASE(indice)) {
+			variantes[indice] = VARIANTE_DECALEE;
+		} else {
+			variantes[indice] = VARIANTE_NORMALE;
+		}
+	}
+
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		for(uint8_t indice = 0; indice != NB_CASES; indice++) {
+			image[ligne][indice] = glyphe(variantes[indice], pDisposition.cases[indice], ligne);
 		}
 	}
 }
 
 /**
- * \brief   Affichage d'un nombre avec un chiffres après la virgule et pourcent. 
+ * \brief   Démarre le défilement d'un texte
+ *
+ * \details Le texte entre par la droite de la chaine, une colonne par appel de defile().
+ *          Caractères : chiffres, '-', '%', '*' pour le degré, ' ', ':', '.' et ','.
+ *          Un caractère inconnu est remplacé par un espace.
  *
- * \details Affichage des chiffres sur les 8 segments des 3 matrices et pourcent à la fin
+ * \param   pTexte le texte, terminé par un 0
  *
- * \param   pDizaine
- * \param   pUnite
- * \param   pDizieme
+ * \attention le texte n'est pas copié, il doit rester valable pendant tout le défilement
  */
-void GestionMatrices::dizainePourcent(uint8_t pDizaine, uint8_t pUnite, uint8_t pDizieme) 
+template<uint8_t N>
+void GestionMatrices<N>::texte(const char *pTexte)
 {
-	// Affichage des caractères sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segmentPourcent(compteur), true, false);
-			maxTransfer(0x01, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x01, segment(pDizaine, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segmentPourcent(compteur), true, false);
-			maxTransfer(0x02, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x02, segment(pDizaine, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segmentPourcent(compteur), true, false);
-			maxTransfer(0x03, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x03, segment(pDizaine, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segmentPourcent(compteur), true, false);
-			maxTransfer(0x04, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x04, segment(pDizaine, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segmentPourcent(compteur), true, false);
-			maxTransfer(0x05, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x05, segment(pDizaine, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segmentPourcent(compteur), true, false);
-			maxTransfer(0x06, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x06, segment(pDizaine, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segmentPourcent(compteur), true, false);
-			maxTransfer(0x07, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x07, segment(pDizaine, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segmentPourcent(compteur), true, false);
-			maxTransfer(0x08, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, false);
-			maxTransfer(0x08, segment(pDizaine, compteur), false, true);
-			break;
-		}
-	}
+	texteDefilant = pTexte;
+	horlogeAffichee = false;
+	largeur = 0;
+	colonneCourante = 0;
+	colonnesFinales = N * 8;
 }
 
 /**
- * \brief   Affichage d'un nombre avec trois chiffres après la virgule. 
+ * \brief   Image suivante du texte défilant
  *
- * \details Affichage des chiffres sur les 8 segments des 4 matrices
+ * \details Décale l'image d'une colonne vers la gauche, fait entrer à droite
+ *          la colonne suivante du texte et applique l'image par commit(), sans extinction :
+ *          une image intermédiaire ne diffère que d'une colonne, à 30 images par seconde
+ *          l'extinction ferait clignoter le texte.
+ *          Coût borné : 8 * N décalages, au plus 8 lectures en flash, 8 lignes et 2 commandes envoyées.
  *
- * \param   pUnite
- * \param   pDizieme
- * \param   pCentieme
- * \param   pMillieme
+ * \return  false quand le texte est entièrement sorti à gauche, l'image n'est alors plus modifiée
  */
-void GestionMatrices::unite(uint8_t pUnite, uint8_t pDizieme, uint8_t pCentieme, uint8_t pMillieme) 
+template<uint8_t N>
+bool GestionMatrices<N>::defile(void)
 {
-	// Affichage des chiffres sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segment(pMillieme, compteur), true, false);
-			maxTransfer(0x01, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x01, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segment(pMillieme, compteur), true, false);
-			maxTransfer(0x02, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x02, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segment(pMillieme, compteur), true, false);
-			maxTransfer(0x03, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x03, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segment(pMillieme, compteur), true, false);
-			maxTransfer(0x04, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x04, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segment(pMillieme, compteur), true, false);
-			maxTransfer(0x05, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x05, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segment(pMillieme, compteur), true, false);
-			maxTransfer(0x06, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x06, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segment(pMillieme, compteur), true, false);
-			maxTransfer(0x07, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x07, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segment(pMillieme, compteur), true, false);
-			maxTransfer(0x08, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x08, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, true);
-			break;
+	if(texteDefilant == 0) {
+		return(false);
+	}
+	
+	uint8_t colonne = colonneSuivante();
+	for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+		// Le bit 7 est la colonne de gauche d'une matrice, il passe dans la matrice voisine
+		uint8_t retenue = (colonne >> ligne) & 0x01;
+		for(uint8_t module = N; module != 0; module--) {
+			uint8_t octet = image[ligne][module - 1];
+			image[ligne][module - 1] = (octet << 1) | retenue;
+			retenue = octet >> 7;
 		}
 	}
+	commit();
+	return(true);
 }
 
 /**
- * \brief   Affichage d'un nombre avec deux chiffres après la virgule et dégré. 
+ * \brief   Colonne suivante du texte défilant
  *
- * \details Affichage des chiffres sur les 8 segments des 3 matrices et degré à la fin
+ * \details Après le dernier caractère, N * 8 colonnes vides font sortir le texte.
+ *          Le défilement s'arrête à la dernière.
  *
- * \param   pUnite
- * \param   pDizieme
- * \param   pCentieme
+ * \return  la colonne, bit 0 = ligne du haut
  */
-void GestionMatrices::uniteDeg(uint8_t pUnite, uint8_t pDizieme, uint8_t pCentieme) 
+template<uint8_t N>
+uint8_t GestionMatrices<N>::colonneSuivante(void)
 {
-	// Affichage des caractères sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segmentDeg(compteur), true, false);
-			maxTransfer(0x01, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x01, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segmentDeg(compteur), true, false);
-			maxTransfer(0x02, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x02, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segmentDeg(compteur), true, false);
-			maxTransfer(0x03, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x03, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segmentDeg(compteur), true, false);
-			maxTransfer(0x04, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x04, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segmentDeg(compteur), true, false);
-			maxTransfer(0x05, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x05, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segmentDeg(compteur), true, false);
-			maxTransfer(0x06, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x06, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segmentDeg(compteur), true, false);
-			maxTransfer(0x07, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x07, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segmentDeg(compteur), true, false);
-			maxTransfer(0x08, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x08, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, true);
-			break;
+	if(colonneCourante == largeur) {
+		if(*texteDefilant != 0) {
+			chargeCaractere(*texteDefilant++);
+		} else {
+			if(--colonnesFinales == 0) {
+				texteDefilant = 0;
+			}
+			return(0x00);
 		}
 	}
+	return(colonnes[colonneCourante++]);
 }
 
 /**
- * \brief   Affichage d'un nombre avec deux chiffres après la virgule et pourcent. 
+ * \brief   Prépare les colonnes d'un caractère du texte défilant
  *
- * \details Affichage des chiffres sur les 8 segments des 3 matrices et pourcent à la fin
+ * \details Les glyphes des chiffres et symboles sont lus une seule fois en flash
+ *          puis transposés en colonnes. Les colonnes vides de part et d'autre
+ *          sont retirées pour un espacement proportionnel.
  *
- * \param   pUnite
- * \param   pDizieme
- * \param   pCentieme
+ * \param   pCaractere le caractère
  */
-void GestionMatrices::unitePourcent(uint8_t pUnite, uint8_t pDizieme, uint8_t pCentieme) 
+template<uint8_t N>
+void GestionMatrices<N>::chargeCaractere(char pCaractere)
 {
-	// Affichage des caractères sur les 8 segments des 4 afficheurs
-	// Peut être simplifié, mais c'est plus compréhensible comme ça
-	for(uint8_t compteur = 0; compteur != 8; compteur++) {
-		switch(compteur) {
-		case 0:
-			maxTransfer(0x01, segmentPourcent(compteur), true, false);
-			maxTransfer(0x01, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x01, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x01, segmentV(pUnite, compteur), false, true);
-			break;
-		case 1:
-			maxTransfer(0x02, segmentPourcent(compteur), true, false);
-			maxTransfer(0x02, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x02, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x02, segmentV(pUnite, compteur), false, true);
-			break;
-		case 2:
-			maxTransfer(0x03, segmentPourcent(compteur), true, false);
-			maxTransfer(0x03, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x03, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x03, segmentV(pUnite, compteur), false, true);
-			break;
-		case 3:
-			maxTransfer(0x04, segmentPourcent(compteur), true, false);
-			maxTransfer(0x04, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x04, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x04, segmentV(pUnite, compteur), false, true);
-			break;
-		case 4:
-			maxTransfer(0x05, segmentPourcent(compteur), true, false);
-			maxTransfer(0x05, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x05, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x05, segmentV(pUnite, compteur), false, true);
-			break;
-		case 5:
-			maxTransfer(0x06, segmentPourcent(compteur), true, false);
-			maxTransfer(0x06, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x06, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x06, segmentV(pUnite, compteur), false, true);
-			break;
-		case 6:
-			maxTransfer(0x07, segmentPourcent(compteur), true, false);
-			maxTransfer(0x07, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x07, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x07, segmentV(pUnite, compteur), false, true);
-			break;
-		case 7:
-			maxTransfer(0x08, segmentPourcent(compteur), true, false);
-			maxTransfer(0x08, segment(pCentieme, compteur), false, false);
-			maxTransfer(0x08, segment(pDizieme, compteur), false, false);
-			maxTransfer(0x08, segmentV(pUnite, compteur), false, true);
+	uint8_t code = CAR_VIDE;
+	largeur = 0;
+	colonneCourante = 0;
+	switch(pCaractere) {
+		case ':':
+			// Lignes 2 et 5
+			colonnes[largeur++] = 0x24;
+			break;
+		case '.':
+		case ',':
+			// Ligne du bas
+			colonnes[largeur++] = 0x80;
+			break;
+		case '-':
+			code = CAR_MOINS;
+			break;
+		case '%':
+			code = CAR_POURCENT;
+			break;
+		case '*':
+			code = CAR_DEGRE;
+			break;
+		default:
+			if(pCaractere >= '0' && pCaractere <= '9') {
+				code = pCaractere - '0';
+			} else {
+				memset(colonnes, 0x00, LARGEUR_ESPACE);
+				largeur = LARGEUR_ESPACE;
+			}
 			break;
+	}
+	
+	if(code != CAR_VIDE) {
+		uint8_t lignes[NB_LIGNES];
+		for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+			lignes[ligne] = glyphe(VARIANTE_NORMALE, code, ligne);
+		}
+		// Transposition, de la colonne de gauche (bit 7) à celle de droite
+		for(uint8_t masque = 0x80; masque != 0; masque >>= 1) {
+			uint8_t colonne = 0x00;
+			for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+				if(lignes[ligne] & masque) {
+					colonne |= 1 << ligne;
+				}
+			}
+			// Colonnes vides de gauche ignorées
+			if(colonne != 0x00 || largeur != 0) {
+				colonnes[largeur++] = colonne;
+			}
+		}
+		// Colonnes vides de droite retirées
+		while(largeur != 0 && colonnes[largeur - 1] == 0x00) {
+			largeur--;
 		}
 	}
+	
+	// Espacement avec le caractère suivant
+	for(uint8_t espace = 0; espace != ESPACE_CARACTERES; espace++) {
+		colonnes[largeur++] = 0x00;
+	}
 }
 
 /**
@@ -1121,10 +689,16 @@ void GestionMatrices::unitePourcent(uint8_t pUnite, uint8_t pDizieme, uint8_t pC
  *
  * \note    Appelé automatiquement à la fin du programme
  */
-GestionMatrices::~GestionMatrices(void)
+template<uint8_t N>
+GestionMatrices<N>::~GestionMatrices(void)
 {
 }
 
+// Longueurs de chaine disponibles
+template class GestionMatrices<4>;
+template class GestionMatrices<8>;
+template class GestionMatrices<16>;
+
 /*! \class GestionMatrices 
  *  \brief Class pour l'affichage sur les matrices à base de MAX7219.
  *
@@ -11,42 +11,126 @@
 
 #include <stdint.h>
 #include <TimeLib.h>
+#include "Formatage.h"
+#include "ChaineMatrices.h"
+#include "Orientation.h"
 
-class GestionMatrices {
+/**
+ *   \brief   Fréquence SPI maximale du MAX7219
+ */ 
+#define FREQUENCE_SPI 10000000
+
+/**
+ *   \brief   Colonnes vides entre deux caractères du texte défilant
+ */ 
+#define ESPACE_CARACTERES 1
+
+/**
+ *   \brief   Largeur d'un espace du texte défilant
+ */ 
+#define LARGEUR_ESPACE 3
+
+/**
+ *   \brief   Pixels des deux points de l'horloge : colonne de droite de la matrice 1, lignes 3 et 6
+ *
+ *   \details Ceux des glyphes VARIANTE_DEUX_POINTS
+ */ 
+#define MODULE_DEUX_POINTS 1
+#define MASQUE_DEUX_POINTS 0x01
+#define LIGNE_DEUX_POINTS_1 3
+#define LIGNE_DEUX_POINTS_2 6
+
+/**
+ *   \brief   Barre des secondes de l'horloge : colonne de droite de la matrice 3, remplie du bas vers le haut
+ */ 
+#define MODULE_SECONDES 3
+#define MASQUE_SECONDES 0x01
+
+/**
+ *   \brief   Baisse de la pression : colonne de gauche de la matrice 0, lignes 5 à 7
+ *
+ *   \details Colonne toujours éteinte par la dizaine d'heures (0, 1 ou 2)
+ */ 
+#define MODULE_BAISSE 0
+#define MASQUE_BAISSE 0x80
+#define LIGNE_BAISSE 5
+
+/**
+ *   \brief   Gestion d'une chaine de N matrices MAX7219
+ *
+ *   \details Les affichages de chiffres utilisent les 4 premières matrices
+ *            (à gauche), les suivantes ne sont pas modifiées.
+ *            Le texte défilant utilise toute la chaine.
+ *            Chaines disponibles : 4, 8 et 16 matrices.
+ *            Plusieurs chaines sur des broches CS différentes partagent le même BusSpi.
+ */ 
+template<uint8_t N>
+class GestionMatrices : public ChaineMatrices {
+	static_assert(N >= 4, "Il faut au moins 4 matrices pour l'affichage des chiffres");
+	
 	public:
-		GestionMatrices(uint8_t);
+		GestionMatrices(BusSpi &, uint8_t);
 		
 		void horloge(tmElements_t);
+		void deuxPoints(bool);
+		void secondes(uint8_t);
+		void baisse(bool);
+		void calque(uint8_t, uint8_t, uint8_t, uint8_t);
+		void effaceCalque(void);
 		void affichage(float);
 		void affichageDeg(float);
 		void affichagePourcent(float);
+		void affichage(int32_t, uint8_t, uint8_t);
+		void affichage(const Disposition &);
+		
+		void texte(const char *);
+		bool defile(void);
 		
-		void intensity(uint8_t);
+		void flush(void);
+		void commit(void);
+		void forceRefresh(void);
+		unsigned long latence(void);
 		
 		virtual ~GestionMatrices(void);
 		
 	private:
-		void heure(uint8_t, uint8_t, uint8_t, uint8_t); 
-		void millier(uint8_t, uint8_t, uint8_t, uint8_t); 
-		void centaine(uint8_t, uint8_t, uint8_t, uint8_t); 
-		void centaineDeg(uint8_t, uint8_t, uint8_t); 
-		void centainePourcent(uint8_t, uint8_t, uint8_t); 
-		void dizaine(uint8_t, uint8_t, uint8_t, uint8_t); 
-		void dizaineDeg(uint8_t, uint8_t, uint8_t); 
-		void dizainePourcent(uint8_t, uint8_t, uint8_t); 
-		void unite(uint8_t, uint8_t, uint8_t, uint8_t); 
-		void uniteDeg(uint8_t, uint8_t, uint8_t); 
-		void unitePourcent(uint8_t, uint8_t, uint8_t); 
 		void reset(void);
-		void maxTransfer(uint8_t, uint8_t, bool, bool);
-		uint8_t segment(uint8_t, uint8_t);
-		uint8_t segmentDeg(uint8_t);
-		uint8_t segmentPourcent(uint8_t);
-		uint8_t segmentDp(uint8_t, uint8_t);
-		uint8_t segmentDm(uint8_t, uint8_t);
-		uint8_t segmentV(uint8_t, uint8_t);
+		uint8_t lignesModifiees(void);
+		void oriente(void);
+		const uint8_t *sortie(uint8_t);
+		void envoiLigne(uint8_t);
+		void envoiRegistre(uint8_t, uint8_t);
+		void dessine(const Disposition &);
+		void commande(uint8_t, uint8_t);
+		void transfert(void);
+		uint8_t glyphe(uint8_t, uint8_t, uint8_t);
+		uint8_t colonneSuivante(void);
+		void chargeCaractere(char);
+		
+		// Image à afficher, module 0 à gauche
+		uint8_t image[NB_LIGNES][N];
+		// Copie des registres lignes des MAX7219, dans leur orientation
+		uint8_t registres[NB_LIGNES][N];
+#if ORIENTATION_MATRICES != ORIENTATION_NORMALE
+		// Image convertie dans l'orientation des MAX7219, registre 0x01 en ligne 0
+		uint8_t materiel[NB_LIGNES][N];
+#endif
+		// Calque de l'horloge : pixels imposés (masques) et leur état (valeurs)
+		uint8_t masques[NB_LIGNES][N];
+		uint8_t valeurs[NB_LIGNES][N];
+		// Le calque n'est appliqué que sur l'horloge
+		bool horlogeAffichee;
+		// Couples registre/valeur d'un transfert, matrice de droite en premier
+		uint8_t tampon[2 * N];
 		
-		uint8_t cs;
+		// Texte défilant, 0 si aucun
+		const char *texteDefilant;
+		// Colonnes du caractère en cours d'entrée, bit 0 = ligne 0
+		uint8_t colonnes[NB_LIGNES + ESPACE_CARACTERES];
+		uint8_t largeur;
+		uint8_t colonneCourante;
+		// Colonnes vides restant à entrer pour que le texte sorte à gauche
+		uint8_t colonnesFinales;
 };
 
 #endif
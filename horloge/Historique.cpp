@@ -0,0 +1,241 @@
+/*!
+ *   \file    Historique.cpp
+ *   \brief   Historique compact d'une mesure
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include "Historique.h"
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details Historique vide
+ */
+template<uint16_t TAILLE>
+Historique<TAILLE>::Historique(void)
+{
+	tete = 0;
+	queue = 0;
+	occupe = 0;
+	nbEchantillons = 0;
+	valeurPremier = 0;
+	valeurDernier = 0;
+	sommeY = 0;
+	sommeXY = 0;
+	nouveauJour();
+}
+
+/**
+ * \brief Ajoute un échantillon
+ *
+ * \details Les plus anciens sont oubliés pour faire la place de l'écart
+ *
+ * \param pValeur la valeur en unité entière (ex. 1/10 hPa)
+ */
+template<uint16_t TAILLE>
+void Historique<TAILLE>::ajoute(int32_t pValeur)
+{
+	if(nbEchantillons == NB_ECHANTILLONS_MAX) {
+		oublie();
+	}
+
+	if(nbEchantillons == 0) {
+		valeurPremier = pValeur;
+	} else {
+		// Zigzag : les petits écarts négatifs donnent aussi de petits nombres
+		int32_t ecart = pValeur - valeurDernier;
+		uint32_t code = ((uint32_t)ecart << 1) ^ (uint32_t)(ecart >> 31);
+		uint8_t octets[OCTETS_ECART_MAX];
+		uint8_t longueur = 0;
+		while(code >= 0x80) {
+			octets[longueur++] = (uint8_t)code | 0x80;
+			code >>= 7;
+		}
+		octets[longueur++] = (uint8_t)code;
+
+		// Un seul échantillon laisse le tampon vide, où tient toujours un écart
+		while(libre() < longueur) {
+			oublie();
+		}
+		for(uint8_t indice = 0; indice != longueur; indice++) {
+			tampon[tete] = octets[indice];
+			tete = (tete + 1) % TAILLE;
+		}
+		occupe += longueur;
+	}
+
+	// Le nouvel échantillon a le rang nbEchantillons
+	sommeY += pValeur;
+	sommeXY += (int64_t)nbEchantillons * pValeur;
+	nbEchantillons++;
+	valeurDernier = pValeur;
+
+	if(!extremes || pValeur < min) {
+		min = pValeur;
+	}
+	if(!extremes || pValeur > max) {
+		max = pValeur;
+	}
+	extremes = true;
+}
+
+/**
+ * \brief Oublie le plus ancien échantillon
+ *
+ * \details Le suivant devient le premier : son écart est décodé et retiré du tampon.
+ *          Les rangs diminuent tous de 1, la somme des x * y diminue de la somme des y restants.
+ */
+template<uint16_t TAILLE>
+void Historique<TAILLE>::oublie(void)
+{
+	if(nbEchantillons == 0) {
+		return;
+	}
+	sommeY -= valeurPremier;
+	sommeXY -= sommeY;
+	nbEchantillons--;
+	if(nbEchantillons == 0) {
+		return;
+	}
+
+	uint32_t code = 0;
+	uint8_t decalage = 0;
+	uint8_t octet;
+	do {
+		octet = tampon[queue];
+		queue = (queue + 1) % TAILLE;
+		occupe--;
+		code |= (uint32_t)(octet & 0x7F) << decalage;
+		decalage += 7;
+	} while(octet & 0x80);
+	valeurPremier += (int32_t)(code >> 1) ^ -(int32_t)(code & 0x01);
+}
+
+/**
+ * \brief Place libre dans le tampon
+ */
+template<uint16_t TAILLE>
+uint16_t Historique<TAILLE>::libre(void)
+{
+	return(TAILLE - occupe);
+}
+
+/**
+ * \brief Début d'une nouvelle journée pour le minimum et le maximum
+ */
+template<uint16_t TAILLE>
+void Historique<TAILLE>::nouveauJour(void)
+{
+	min = 0;
+	max = 0;
+	extremes = false;
+}
+
+/**
+ * \brief Nombre d'échantillons de la fenêtre
+ */
+template<uint16_t TAILLE>
+uint16_t Historique<TAILLE>::nombre(void)
+{
+	return(nbEchantillons);
+}
+
+/**
+ * \brief Dernier échantillon
+ *
+ * \return la valeur, 0 si l'historique est vide
+ */
+template<uint16_t TAILLE>
+int32_t Historique<TAILLE>::dernier(void)
+{
+	return(valeurDernier);
+}
+
+/**
+ * \brief Minimum depuis le dernier nouveauJour()
+ *
+ * \return la valeur, 0 sans échantillon
+ */
+template<uint16_t TAILLE>
+int32_t Historique<TAILLE>::minimum(void)
+{
+	return(min);
+}
+
+/**
+ * \brief Maximum depuis le dernier nouveauJour()
+ *
+ * \return la valeur, 0 sans échantillon
+ */
+template<uint16_t TAILLE>
+int32_t Historique<TAILLE>::maximum(void)
+{
+	return(max);
+}
+
+/**
+ * \brief Minimum et maximum disponibles
+ *
+ * \return false sans échantillon depuis le dernier nouveauJour()
+ */
+template<uint16_t TAILLE>
+bool Historique<TAILLE>::extremesConnus(void)
+{
+	return(extremes);
+}
+
+/**
+ * \brief Moyenne de la fenêtre
+ *
+ * \return la moyenne, 0 si l'historique est vide
+ */
+template<uint16_t TAILLE>
+float Historique<TAILLE>::moyenne(void)
+{
+	if(nbEchantillons == 0) {
+		return(0.0F);
+	}
+	return((float)sommeY / nbEchantillons);
+}
+
+/**
+ * \brief Tendance de la fenêtre
+ *
+ * \details Pente de la droite des moindres carrés, 
+ *          les sommes des x et des x² ne dépendent que du nombre d'échantillons.
+ *
+ * \return la variation par échantillon, 0 avec moins de 2 échantillons
+ */
+template<uint16_t TAILLE>
+float Historique<TAILLE>::tendance(void)
+{
+	if(nbEchantillons < 2) {
+		return(0.0F);
+	}
+	// Calcul exact en entiers, la soustraction en float perdrait la pente
+	int64_t n = nbEchantillons;
+	int64_t sommeX = n * (n - 1) / 2;
+	int64_t sommeX2 = sommeX * (2 * n - 1) / 3;
+	return((float)(n * sommeXY - sommeX * sommeY) / (float)(n * sommeX2 - sommeX * sommeX));
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+template<uint16_t TAILLE>
+Historique<TAILLE>::~Historique(void)
+{
+}
+
+// Tailles disponibles
+template class Historique<128>;
+template class Historique<288>;
+
+/*! \class Historique 
+ *  \brief Historique glissant codé en écarts, moyenne, tendance et extrêmes en O(1).
+ *
+ */
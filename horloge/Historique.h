@@ -0,0 +1,78 @@
+/*!
+ *   \file    Historique.h
+ *   \brief   Entete de l'historique compact d'une mesure
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef HISTORIQUE_H_
+#define HISTORIQUE_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Nombre maximum d'échantillons, 24 h à 5 minutes
+ */ 
+#define NB_ECHANTILLONS_MAX 288
+
+/**
+ *   \brief   Octets maximum d'un écart codé (varint de 32 bits)
+ */ 
+#define OCTETS_ECART_MAX 5
+
+/**
+ *   \brief   Historique glissant d'une mesure entière sur TAILLE octets
+ *
+ *   \details Le plus ancien échantillon est gardé en clair, les suivants sont les écarts
+ *            avec leur prédécesseur, en zigzag puis varint : un écart entre -64 et 63 tient
+ *            sur un octet. Quand la place ou le nombre d'échantillons manque, 
+ *            le plus ancien est oublié.
+ *            Moyenne et tendance de la fenêtre en O(1) par des sommes tenues à jour,
+ *            minimum et maximum depuis le dernier nouveauJour().
+ *            Tailles disponibles : 128 et 288 octets.
+ */ 
+template<uint16_t TAILLE>
+class Historique {
+	static_assert(TAILLE >= OCTETS_ECART_MAX, "Le tampon doit contenir au moins un écart");
+	
+	public:
+		Historique(void);
+		
+		void ajoute(int32_t);
+		void nouveauJour(void);
+		
+		uint16_t nombre(void);
+		int32_t dernier(void);
+		int32_t minimum(void);
+		int32_t maximum(void);
+		bool extremesConnus(void);
+		float moyenne(void);
+		float tendance(void);
+		
+		virtual ~Historique(void);
+		
+	private:
+		void oublie(void);
+		uint16_t libre(void);
+		
+		// Ecarts codés, de queue (le plus ancien) à tete
+		uint8_t tampon[TAILLE];
+		uint16_t tete;
+		uint16_t queue;
+		uint16_t occupe;
+		
+		uint16_t nbEchantillons;
+		int32_t valeurPremier;
+		int32_t valeurDernier;
+		
+		// Sommes de la fenêtre, x = rang depuis le plus ancien
+		int32_t sommeY;
+		int64_t sommeXY;
+		
+		int32_t min;
+		int32_t max;
+		bool extremes;
+};
+
+#endif
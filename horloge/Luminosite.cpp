@@ -0,0 +1,124 @@
+/*!
+ *   \file    Luminosite.cpp
+ *   \brief   Réglage automatique de l'intensité des matrices
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include "Luminosite.h"
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details Intensité minimale, comme les matrices à leur initialisation
+ *
+ * \param   pFondu true pour changer d'intensité un niveau à la fois
+ */
+Luminosite::Luminosite(bool pFondu)
+{
+	lisse = 0;
+	premiere = true;
+	progressif = pFondu;
+	cible = 0;
+	courant = 0;
+}
+
+/**
+ * \brief Logarithme en base 2 en virgule fixe
+ *
+ * \details Partie entière par la position du bit de poids fort, 
+ *          partie fractionnaire approchée par les 8 bits suivants (erreur < 0,09).
+ *
+ * \param pValeur la valeur, 0 donne 0
+ *
+ * \return log2 en 1/256
+ */
+uint16_t Luminosite::log2(uint16_t pValeur)
+{
+	if(pValeur == 0) {
+		return(0);
+	}
+	uint8_t exposant = 15;
+	while(!(pValeur & 0x8000)) {
+		pValeur <<= 1;
+		exposant--;
+	}
+	return(((uint16_t)exposant << 8) | ((pValeur >> 7) & 0xFF));
+}
+
+/**
+ * \brief Prise en compte d'une mesure d'éclairement
+ *
+ * \param pLux l'éclairement en lux
+ *
+ * \return true si l'intensité a changé et doit être envoyée aux matrices
+ */
+bool Luminosite::mesure(float pLux)
+{
+	// 0 lux donne log2(1) = 0, une erreur du luxmètre (valeur négative) aussi
+	uint16_t lux = 1;
+	if(pLux >= 65534.0F) {
+		lux = 65535;
+	} else if(pLux > 0.0F) {
+		lux = (uint16_t)pLux + 1;
+	}
+	uint16_t valeur = log2(lux);
+	if(premiere) {
+		lisse = valeur;
+		premiere = false;
+	} else {
+		lisse += ((int16_t)(valeur - lisse)) >> LISSAGE;
+	}
+
+	// Position en 1/16 de niveau
+	uint16_t position = lisse >= LOG_LUX_MAX ? INTENSITE_MAX * 16 : (uint32_t)lisse * (INTENSITE_MAX * 16) / LOG_LUX_MAX;
+	// Changement de niveau seulement au-delà du milieu et de l'hystérésis
+	if(position > cible * 16 + 8 + HYSTERESIS || position + 8 + HYSTERESIS < cible * 16) {
+		cible = (position + 8) / 16;
+	}
+
+	uint8_t precedent = courant;
+	if(!progressif) {
+		courant = cible;
+	} else if(courant < cible) {
+		courant++;
+	} else if(courant > cible) {
+		courant--;
+	}
+	return(courant != precedent);
+}
+
+/**
+ * \brief Intensité à envoyer aux matrices
+ *
+ * \return l'intensité entre 0x00 et INTENSITE_MAX
+ */
+uint8_t Luminosite::niveau(void)
+{
+	return(courant);
+}
+
+/**
+ * \brief Choix du fondu
+ *
+ * \param pFondu true pour changer d'intensité un niveau par mesure
+ */
+void Luminosite::fondu(bool pFondu)
+{
+	progressif = pFondu;
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+Luminosite::~Luminosite(void)
+{
+}
+
+/*! \class Luminosite 
+ *  \brief Intensité des matrices : courbe logarithmique, lissage, hystérésis et fondu.
+ *
+ */
@@ -0,0 +1,62 @@
+/*!
+ *   \file    Luminosite.h
+ *   \brief   Entete du réglage automatique de l'intensité des matrices
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef LUMINOSITE_H_
+#define LUMINOSITE_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Intensité maximale du MAX7219
+ */ 
+#define INTENSITE_MAX 0x0F
+
+/**
+ *   \brief   log2(20000 lux) en 1/256, par Luminosite::log2() : 20000 lux et plus donnent l'intensité maximale
+ */ 
+#define LOG_LUX_MAX 3640
+
+/**
+ *   \brief   Lissage exponentiel, nouvelle mesure comptée pour 1/2^LISSAGE
+ */ 
+#define LISSAGE 2
+
+/**
+ *   \brief   Hystérésis en 1/16 de niveau, au-delà du milieu entre deux niveaux
+ */ 
+#define HYSTERESIS 4
+
+/**
+ *   \brief   Intensité des matrices d'après l'éclairement
+ *
+ *   \details Courbe logarithmique en virgule fixe (l'œil perçoit des rapports d'éclairement),
+ *            lissage exponentiel, hystérésis entre niveaux et fondu optionnel
+ *            d'un niveau par mesure.
+ */ 
+class Luminosite {
+	public:
+		Luminosite(bool);
+		
+		bool mesure(float);
+		uint8_t niveau(void);
+		void fondu(bool);
+		
+		static uint16_t log2(uint16_t);
+		
+		virtual ~Luminosite(void);
+		
+	private:
+		// log2 lissé de l'éclairement, en 1/256
+		uint16_t lisse;
+		bool premiere;
+		bool progressif;
+		uint8_t cible;
+		uint8_t courant;
+};
+
+#endif
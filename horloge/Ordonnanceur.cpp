@@ -0,0 +1,161 @@
+/*!
+ *   \file    Ordonnanceur.cpp
+ *   \brief   Ordonnanceur coopératif basé sur millis()
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include "Ordonnanceur.h"
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details Aucune tâche
+ */
+Ordonnanceur::Ordonnanceur(void)
+{
+	for(uint8_t indice = 0; indice != NB_TACHES_MAX; indice++) {
+		taches[indice].fonction = 0;
+		taches[indice].active = false;
+	}
+}
+
+/**
+ * \brief Ajoute une tâche périodique
+ *
+ * \param pFonction la fonction à exécuter
+ * \param pPeriode la période en ms, première exécution après une période
+ *
+ * \return l'identifiant de la tâche ou TACHE_AUCUNE
+ */
+int8_t Ordonnanceur::periodique(FonctionTache pFonction, unsigned long pPeriode)
+{
+	return(ajoute(pFonction, pPeriode, false));
+}
+
+/**
+ * \brief Ajoute une tâche exécutée une seule fois
+ *
+ * \details La tâche reste réservée après son exécution et peut être relancée
+ *
+ * \param pFonction la fonction à exécuter
+ * \param pDelai le délai en ms avant l'exécution
+ *
+ * \return l'identifiant de la tâche ou TACHE_AUCUNE
+ */
+int8_t Ordonnanceur::unique(FonctionTache pFonction, unsigned long pDelai)
+{
+	return(ajoute(pFonction, pDelai, true));
+}
+
+/**
+ * \brief Réarme une tâche, le délai repart de maintenant
+ *
+ * \param pTache l'identifiant de la tâche
+ * \param pDelai le nouveau délai ou la nouvelle période en ms
+ */
+void Ordonnanceur::relance(int8_t pTache, unsigned long pDelai)
+{
+	if(pTache < 0 || pTache >= NB_TACHES_MAX || taches[pTache].fonction == 0) {
+		return;
+	}
+	taches[pTache].depart = millis();
+	taches[pTache].periode = pDelai;
+	taches[pTache].active = true;
+}
+
+/**
+ * \brief Suspend une tâche sans libérer sa place
+ *
+ * \param pTache l'identifiant de la tâche
+ */
+void Ordonnanceur::arrete(int8_t pTache)
+{
+	if(pTache < 0 || pTache >= NB_TACHES_MAX) {
+		return;
+	}
+	taches[pTache].active = false;
+}
+
+/**
+ * \brief Indique si une tâche attend son échéance
+ *
+ * \param pTache l'identifiant de la tâche
+ */
+bool Ordonnanceur::active(int8_t pTache)
+{
+	if(pTache < 0 || pTache >= NB_TACHES_MAX) {
+		return(false);
+	}
+	return(taches[pTache].active);
+}
+
+/**
+ * \brief Exécute les tâches arrivées à échéance
+ *
+ * \details A appeler à chaque tour de loop(). 
+ *          Les comparaisons se font sur des durées (millis() - depart),
+ *          ce qui reste juste au passage à 0 de millis() après 49 jours.
+ *          Une tâche périodique en retard de plus d'une période ne rattrape
+ *          pas les exécutions manquées.
+ */
+void Ordonnanceur::execute(void)
+{
+	for(uint8_t indice = 0; indice != NB_TACHES_MAX; indice++) {
+		Tache &tache = taches[indice];
+		if(!tache.active) {
+			continue;
+		}
+		unsigned long maintenant = millis();
+		unsigned long ecoule = maintenant - tache.depart;
+		if(ecoule < tache.periode) {
+			continue;
+		}
+		if(tache.unique) {
+			tache.active = false;
+		} else if(ecoule < 2 * tache.periode) {
+			tache.depart += tache.periode;
+		} else {
+			tache.depart = maintenant;
+		}
+		tache.fonction();
+	}
+}
+
+/**
+ * \brief Réserve une place pour une tâche
+ *
+ * \param pFonction la fonction à exécuter
+ * \param pPeriode la période ou le délai en ms
+ * \param pUnique true pour une exécution unique
+ *
+ * \return l'identifiant de la tâche ou TACHE_AUCUNE
+ */
+int8_t Ordonnanceur::ajoute(FonctionTache pFonction, unsigned long pPeriode, bool pUnique)
+{
+	for(uint8_t indice = 0; indice != NB_TACHES_MAX; indice++) {
+		if(taches[indice].fonction == 0) {
+			taches[indice].fonction = pFonction;
+			taches[indice].unique = pUnique;
+			relance(indice, pPeriode);
+			return(indice);
+		}
+	}
+	return(TACHE_AUCUNE);
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+Ordonnanceur::~Ordonnanceur(void)
+{
+}
+
+/*! \class Ordonnanceur 
+ *  \brief Ordonnanceur coopératif : tâches périodiques et tâches uniques sans delay().
+ *
+ */
@@ -0,0 +1,57 @@
+/*!
+ *   \file    Ordonnanceur.h
+ *   \brief   Entete de l'ordonnanceur coopératif basé sur millis()
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef ORDONNANCEUR_H_
+#define ORDONNANCEUR_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Nombre maximum de tâches
+ */ 
+#define NB_TACHES_MAX 8
+
+/**
+ *   \brief   Identifiant renvoyé quand il n'y a plus de place
+ */ 
+#define TACHE_AUCUNE -1
+
+/**
+ *   \brief   Fonction exécutée par une tâche
+ */ 
+typedef void (*FonctionTache)(void);
+
+class Ordonnanceur {
+	public:
+		Ordonnanceur(void);
+		
+		int8_t periodique(FonctionTache, unsigned long);
+		int8_t unique(FonctionTache, unsigned long);
+		void relance(int8_t, unsigned long);
+		void arrete(int8_t);
+		bool active(int8_t);
+		
+		void execute(void);
+		
+		virtual ~Ordonnanceur(void);
+		
+	private:
+		int8_t ajoute(FonctionTache, unsigned long, bool);
+		
+		struct Tache {
+			FonctionTache fonction;
+			unsigned long depart;
+			unsigned long periode;
+			bool active;
+			bool unique;
+		};
+		
+		Tache taches[NB_TACHES_MAX];
+};
+
+#endif
@@ -0,0 +1,166 @@
+/*!
+ *   \file    Orientation.h
+ *   \brief   Câblage des modules MAX7219 : orientation des matrices et ordre de la chaine
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Choisis à la compilation. L'image est toujours dessinée ligne par ligne,
+ *            module 0 à gauche, bit 7 dans la colonne de gauche ; elle est convertie
+ *            dans l'orientation des MAX7219 au moment de l'envoi.
+ *            Avec ORIENTATION_NORMALE, aucune conversion n'est compilée.
+ */
+
+#ifndef ORIENTATION_H_
+#define ORIENTATION_H_
+
+#include <stdint.h>
+
+/**
+ *   \brief   Orientations, à combiner : transposition puis miroirs
+ *
+ *   \details NORMALE : registre 0x01 + n = ligne n, bit 7 = colonne de gauche.
+ *            TRANSPOSEE : registre 0x01 + n = colonne n, bit 7 = ligne du haut.
+ *            MIROIR_H : bits du registre inversés. MIROIR_V : registres inversés.
+ *            Une rotation de 90° suivie d'un miroir est une transposition.
+ */
+#define ORIENTATION_NORMALE    0x00
+#define ORIENTATION_TRANSPOSEE 0x01
+#define ORIENTATION_MIROIR_H   0x02
+#define ORIENTATION_MIROIR_V   0x04
+
+/**
+ *   \brief   Modules FC-16 : tournés de 90° et en miroir
+ */
+#define ORIENTATION_FC16 ORIENTATION_TRANSPOSEE
+
+/**
+ *   \brief   Orientation des matrices de l'horloge
+ */
+#ifndef ORIENTATION_MATRICES
+#define ORIENTATION_MATRICES ORIENTATION_NORMALE
+#endif
+
+/**
+ *   \brief   Ordre de la chaine : module de gauche ou de droite relié à l'Arduino (DIN)
+ */
+#define ORDRE_GAUCHE_PREMIER 0
+#define ORDRE_DROITE_PREMIER 1
+
+/**
+ *   \brief   Ordre de la chaine de l'horloge
+ */
+#ifndef ORDRE_MODULES
+#define ORDRE_MODULES ORDRE_GAUCHE_PREMIER
+#endif
+
+/**
+ * \brief Module destinataire d'un couple registre/valeur d'une trame
+ *
+ * \details Le premier couple envoyé aboutit au bout de la chaine, le plus loin de l'Arduino
+ *
+ * \param pRang le rang du couple dans la trame
+ * \param pModules le nombre de modules de la chaine
+ *
+ * \return le module, 0 à gauche
+ */
+static inline uint8_t moduleEmis(uint8_t pRang, uint8_t pModules)
+{
+	return(ORDRE_MODULES == ORDRE_GAUCHE_PREMIER ? pModules - 1 - pRang : pRang);
+}
+
+/**
+ * \brief Inverse l'ordre des bits d'un octet
+ *
+ * \param pOctet l'octet
+ *
+ * \return bit 7 en bit 0, bit 6 en bit 1...
+ */
+static inline uint8_t inverseOctet(uint8_t pOctet)
+{
+	pOctet = (pOctet >> 4) | (pOctet << 4);
+	pOctet = ((pOctet & 0xCC) >> 2) | ((pOctet & 0x33) << 2);
+	return(((pOctet & 0xAA) >> 1) | ((pOctet & 0x55) << 1));
+}
+
+/**
+ * \brief Transpose une matrice 8x8 d'un bit par pixel
+ *
+ * \details Sur l'AVR, chaque bit passe par la retenue (lsl puis rol) :
+ *          2 cycles par pixel, les 8 colonnes restant dans des registres.
+ *
+ * \param pLignes les 8 lignes, bit 7 à gauche ; remplacées par les 8 colonnes, bit 7 en haut
+ */
+static inline void transposeOctets(uint8_t *pLignes)
+{
+#ifdef __AVR__
+	uint8_t c0 = 0, c1 = 0, c2 = 0, c3 = 0, c4 = 0, c5 = 0, c6 = 0, c7 = 0;
+	for(uint8_t ligne = 0; ligne != 8; ligne++) {
+		uint8_t octet = pLignes[ligne];
+		__asm__(
+			"lsl %8" "\n\t" "rol %0" "\n\t"
+			"lsl %8" "\n\t" "rol %1" "\n\t"
+			"lsl %8" "\n\t" "rol %2" "\n\t"
+			"lsl %8" "\n\t" "rol %3" "\n\t"
+			"lsl %8" "\n\t" "rol %4" "\n\t"
+			"lsl %8" "\n\t" "rol %5" "\n\t"
+			"lsl %8" "\n\t" "rol %6" "\n\t"
+			"lsl %8" "\n\t" "rol %7"
+			: "+r" (c0), "+r" (c1), "+r" (c2), "+r" (c3), "+r" (c4), "+r" (c5), "+r" (c6), "+r" (c7), "+r" (octet)
+		);
+	}
+	pLignes[0] = c0;
+	pLignes[1] = c1;
+	pLignes[2] = c2;
+	pLignes[3] = c3;
+	pLignes[4] = c4;
+	pLignes[5] = c5;
+	pLignes[6] = c6;
+	pLignes[7] = c7;
+#else
+	uint8_t colonnes[8];
+	for(uint8_t colonne = 0; colonne != 8; colonne++) {
+		uint8_t octet = 0;
+		for(uint8_t ligne = 0; ligne != 8; ligne++) {
+			octet = (octet << 1) | ((pLignes[ligne] >> (7 - colonne)) & 0x01);
+		}
+		colonnes[colonne] = octet;
+	}
+	for(uint8_t colonne = 0; colonne != 8; colonne++) {
+		pLignes[colonne] = colonnes[colonne];
+	}
+#endif
+}
+
+/**
+ * \brief Convertit un module de l'image dans l'orientation des MAX7219
+ *
+ * \details Les tests sur ORIENTATION_MATRICES sont résolus à la compilation
+ *
+ * \param pImage la ligne 0 du module dans l'image
+ * \param pMateriel le registre 0x01 du module dans l'image convertie
+ * \param pPas l'écart entre deux lignes, le nombre de modules de la chaine
+ */
+static inline void orienteModule(const uint8_t *pImage, uint8_t *pMateriel, uint8_t pPas)
+{
+	uint8_t lignes[8];
+	for(uint8_t ligne = 0; ligne != 8; ligne++) {
+		lignes[ligne] = pImage[ligne * pPas];
+	}
+	if(ORIENTATION_MATRICES & ORIENTATION_TRANSPOSEE) {
+		transposeOctets(lignes);
+	}
+	for(uint8_t ligne = 0; ligne != 8; ligne++) {
+		uint8_t octet = lignes[ligne];
+		if(ORIENTATION_MATRICES & ORIENTATION_MIROIR_H) {
+			octet = inverseOctet(octet);
+		}
+		if(ORIENTATION_MATRICES & ORIENTATION_MIROIR_V) {
+			pMateriel[(7 - ligne) * pPas] = octet;
+		} else {
+			pMateriel[ligne * pPas] = octet;
+		}
+	}
+}
+
+#endif
@@ -0,0 +1,201 @@
+/*!
+ *   \file    Telemetrie.cpp
+ *   \brief   Télémétrie binaire sur le port série USB
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include "Telemetrie.h"
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \param pSortie le port série (Serial sur le Leonardo)
+ */
+Telemetrie::Telemetrie(Print &pSortie) : sortie(pSortie)
+{
+	premier = 0;
+	nombre = 0;
+	sequence = 0;
+}
+
+/**
+ * \brief Echantillon d'une mesure
+ *
+ * \param pMesure la mesure (MESURE_xxx)
+ * \param pValide false si le capteur n'a pas répondu
+ * \param pValeur la valeur en virgule fixe
+ * \param pDecimales le nombre de décimales de la valeur
+ */
+void Telemetrie::mesure(uint8_t pMesure, bool pValide, int32_t pValeur, uint8_t pDecimales)
+{
+	uint16_t complement = pMesure | (uint16_t)pDecimales << 8;
+	if(!pValide) {
+		complement |= TELEMETRIE_INVALIDE;
+	}
+	enregistre(TELEMETRIE_MESURE, pValeur, complement);
+}
+
+/**
+ * \brief Changement d'intensité des matrices
+ *
+ * \param pLux l'éclairement en lux
+ * \param pIntensite la nouvelle intensité
+ */
+void Telemetrie::luminosite(int32_t pLux, uint8_t pIntensite)
+{
+	enregistre(TELEMETRIE_LUMINOSITE, pLux, pIntensite);
+}
+
+/**
+ * \brief Changement de mode d'affichage
+ *
+ * \param pMode le nouveau mode
+ * \param pAllume false si les matrices sont en veille
+ */
+void Telemetrie::mode(uint8_t pMode, bool pAllume)
+{
+	enregistre(TELEMETRIE_MODE, pMode, pAllume);
+}
+
+/**
+ * \brief Bilan de la boucle principale
+ *
+ * \param pDureeMax la durée maximale d'un tour en µs
+ * \param pTours le nombre de tours par seconde
+ */
+void Telemetrie::boucle(uint32_t pDureeMax, uint16_t pTours)
+{
+	enregistre(TELEMETRIE_BOUCLE, pDureeMax, pTours);
+}
+
+/**
+ * \brief Bilan de consommation
+ *
+ * \param pCharge la charge consommée en µAh
+ * \param pCourant le courant moyen en 1/100 mA
+ */
+void Telemetrie::energie(uint32_t pCharge, uint16_t pCourant)
+{
+	enregistre(TELEMETRIE_ENERGIE, pCharge, pCourant);
+}
+
+/**
+ * \brief Durée cumulée d'un état du bilan de consommation
+ *
+ * \param pEtat l'état (TELEMETRIE_ETAT_xxx)
+ * \param pDuree la durée en ms
+ */
+void Telemetrie::duree(uint8_t pEtat, uint32_t pDuree)
+{
+	enregistre(TELEMETRIE_DUREE, pDuree, pEtat);
+}
+
+/**
+ * \brief Latence de l'affichage
+ *
+ * \param pLatence la durée de la salve du dernier commit en µs
+ * \param pModules le nombre de matrices
+ */
+void Telemetrie::latence(uint32_t pLatence, uint8_t pModules)
+{
+	enregistre(TELEMETRIE_LATENCE, pLatence, pModules);
+}
+
+/**
+ * \brief Construit un paquet dans la file
+ *
+ * \details File pleine : le paquet est perdu mais son numéro de séquence est consommé
+ *
+ * \param pType le type de paquet (TELEMETRIE_xxx)
+ * \param pValeur la valeur
+ * \param pComplement le complément
+ */
+void Telemetrie::enregistre(uint8_t pType, int32_t pValeur, uint16_t pComplement)
+{
+	// Numéro consommé même si le paquet est perdu, le trou compte la perte chez l'hôte
+	uint8_t numero = sequence++;
+	if(nombre == TELEMETRIE_FILE) {
+		return;
+	}
+	uint8_t *paquet = file[(premier + nombre) % TELEMETRIE_FILE];
+	nombre++;
+	
+	uint32_t date = millis();
+	uint32_t valeur = (uint32_t)pValeur;
+	paquet[0] = TELEMETRIE_SYNCHRO_1;
+	paquet[1] = TELEMETRIE_SYNCHRO_2;
+	paquet[TELEMETRIE_TYPE] = pType;
+	paquet[TELEMETRIE_SEQUENCE] = numero;
+	for(uint8_t octet = 0; octet != 4; octet++) {
+		paquet[TELEMETRIE_DATE + octet] = date >> (8 * octet);
+		paquet[TELEMETRIE_VALEUR + octet] = valeur >> (8 * octet);
+	}
+	paquet[TELEMETRIE_COMPLEMENT] = pComplement;
+	paquet[TELEMETRIE_COMPLEMENT + 1] = pComplement >> 8;
+	uint16_t crc = crc16(paquet + TELEMETRIE_TYPE, TELEMETRIE_CRC - TELEMETRIE_TYPE);
+	paquet[TELEMETRIE_CRC] = crc;
+	paquet[TELEMETRIE_CRC + 1] = crc >> 8;
+}
+
+/**
+ * \brief Envoie les paquets que le port accepte sans attendre
+ *
+ * \details Un paquet n'est écrit qu'en entier, à appeler à chaque tour de boucle.
+ *          Un paquet que le port n'accepte pas encore reste en file avec son numéro,
+ *          seule la file pleine fait des trous dans les numéros de séquence.
+ */
+void Telemetrie::envoie(void)
+{
+	while(nombre != 0 && sortie.availableForWrite() >= TELEMETRIE_TAILLE) {
+		sortie.write(file[premier], TELEMETRIE_TAILLE);
+		premier = (premier + 1) % TELEMETRIE_FILE;
+		nombre--;
+	}
+}
+
+/**
+ * \brief Paquets en attente d'envoi
+ *
+ * \return le nombre de paquets dans la file
+ */
+uint8_t Telemetrie::attente(void)
+{
+	return(nombre);
+}
+
+/**
+ * \brief CRC-16/CCITT (polynôme 0x1021, départ 0xFFFF)
+ *
+ * \param pOctets les octets
+ * \param pTaille le nombre d'octets
+ *
+ * \return le CRC
+ */
+uint16_t Telemetrie::crc16(const uint8_t *pOctets, uint8_t pTaille)
+{
+	uint16_t crc = 0xFFFF;
+	while(pTaille--) {
+		crc ^= (uint16_t)*pOctets++ << 8;
+		for(uint8_t bit = 0; bit != 8; bit++) {
+			crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return(crc);
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+Telemetrie::~Telemetrie(void)
+{
+}
+
+/*! \class Telemetrie 
+ *  \brief Paquets binaires de taille fixe avec CRC : mesures, intensité, mode, boucle et consommation.
+ *
+ */
@@ -0,0 +1,128 @@
+/*!
+ *   \file    Telemetrie.h
+ *   \brief   Entete de la télémétrie binaire sur le port série USB
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef TELEMETRIE_H_
+#define TELEMETRIE_H_
+
+#include <stdint.h>
+
+class Print;
+
+/**
+ *   \brief   Octets de synchronisation en tête de paquet
+ */ 
+#define TELEMETRIE_SYNCHRO_1 0xAA
+#define TELEMETRIE_SYNCHRO_2 0x55
+
+/**
+ *   \brief   Taille fixe d'un paquet en octets
+ *
+ *   \details 0-1 synchronisation, 2 type, 3 numéro de séquence, 4-7 date en ms, 
+ *            8-11 valeur, 12-13 complément, 14-15 CRC-16/CCITT des octets 2 à 13. 
+ *            Entiers en petit-boutiste.
+ *            Le numéro de séquence est pris à la construction du paquet, pas à son écriture : 
+ *            chaque paquet perdu faute de place dans la file laisse un trou d'un numéro.
+ */ 
+#define TELEMETRIE_TAILLE 16
+
+/**
+ *   \brief   Positions dans le paquet
+ */ 
+#define TELEMETRIE_TYPE       2
+#define TELEMETRIE_SEQUENCE   3
+#define TELEMETRIE_DATE       4
+#define TELEMETRIE_VALEUR     8
+#define TELEMETRIE_COMPLEMENT 12
+#define TELEMETRIE_CRC        14
+
+/**
+ *   \brief   Nombre de paquets en attente d'envoi
+ *
+ *   \details Au-delà le paquet est perdu, le trou dans les numéros de séquence le signale à l'hôte
+ */ 
+#define TELEMETRIE_FILE 8
+
+/**
+ *   \brief   Types de paquet
+ *
+ *   \details TELEMETRIE_MESURE : valeur en virgule fixe, complément = mesure | décimales << 8, 
+ *            mesure invalide si le bit 15 est à 1. 
+ *            TELEMETRIE_LUMINOSITE : valeur = lux, complément = intensité des matrices. 
+ *            TELEMETRIE_MODE : valeur = mode d'affichage, complément = matrices allumées. 
+ *            TELEMETRIE_BOUCLE : valeur = durée maximale d'un tour de boucle en µs, complément = tours par seconde. 
+ *            TELEMETRIE_ENERGIE : valeur = charge consommée en µAh, complément = courant moyen en 1/100 mA. 
+ *            TELEMETRIE_DUREE : valeur = durée cumulée en ms depuis le démarrage, 
+ *            complément = état du bilan (TELEMETRIE_ETAT_xxx). 
+ *            TELEMETRIE_LATENCE : valeur = durée de la salve du dernier commit des matrices en µs, 
+ *            complément = nombre de matrices.
+ */ 
+#define TELEMETRIE_MESURE     1
+#define TELEMETRIE_LUMINOSITE 2
+#define TELEMETRIE_MODE       3
+#define TELEMETRIE_BOUCLE     4
+#define TELEMETRIE_ENERGIE    5
+#define TELEMETRIE_DUREE      6
+#define TELEMETRIE_LATENCE    7
+
+/**
+ *   \brief   Etats des paquets TELEMETRIE_DUREE
+ *
+ *   \details Microcontrôleur actif, en sommeil idle, en power-down (ETAT_xxx de Energie.h), 
+ *            puis matrices allumées et éteintes
+ */ 
+#define TELEMETRIE_ETAT_ACTIF    0
+#define TELEMETRIE_ETAT_REPOS    1
+#define TELEMETRIE_ETAT_ARRET    2
+#define TELEMETRIE_ETAT_ALLUMEES 3
+#define TELEMETRIE_ETAT_ETEINTES 4
+
+/**
+ *   \brief   Bit de mesure invalide dans le complément
+ */ 
+#define TELEMETRIE_INVALIDE 0x8000
+
+/**
+ *   \brief   Paquets de taille fixe horodatés, envoyés sans bloquer la boucle
+ *
+ *   \details Les paquets sont construits dans une file préallouée. 
+ *            envoie() n'écrit que ce que le port accepte sans attendre (availableForWrite), 
+ *            un hôte qui ne lit pas ne ralentit jamais l'horloge.
+ */ 
+class Telemetrie {
+	public:
+		Telemetrie(Print &);
+		
+		void mesure(uint8_t, bool, int32_t, uint8_t);
+		void luminosite(int32_t, uint8_t);
+		void mode(uint8_t, bool);
+		void boucle(uint32_t, uint16_t);
+		void energie(uint32_t, uint16_t);
+		void duree(uint8_t, uint32_t);
+		void latence(uint32_t, uint8_t);
+		
+		void envoie(void);
+		uint8_t attente(void);
+		
+		static uint16_t crc16(const uint8_t *, uint8_t);
+		
+		virtual ~Telemetrie(void);
+		
+	private:
+		void enregistre(uint8_t, int32_t, uint16_t);
+		
+		Print &sortie;
+		
+		// File circulaire de paquets
+		uint8_t file[TELEMETRIE_FILE][TELEMETRIE_TAILLE];
+		uint8_t premier;
+		uint8_t nombre;
+		
+		uint8_t sequence;
+};
+
+#endif
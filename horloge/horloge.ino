@@ -14,18 +14,39 @@
 #include <BH1750.h>
 #include <SparkFun_CAP1203_Registers.h>
 #include <SparkFun_CAP1203_Types.h>
-#include <Adafruit_BMP085.h>
 #include <Adafruit_Sensor.h>
 #include <DHT.h>
 #include <DHT_U.h>
 
 #include "GestionMatrices.h"
+#include "Afficheur.h"
+#include "Ordonnanceur.h"
+#include "Cadence.h"
+#include "Capteurs.h"
+#include "Historique.h"
+#include "Luminosite.h"
+#include "Energie.h"
+#include "Telemetrie.h"
 
 /**
  *   \brief   Broche 6 pour le CS du SPI des matrices
  */ 
 #define LOAD_PIN 6
 
+/**
+ *   \brief   Nombre de matrices chainées
+ */ 
+#define NB_MATRICES 4
+
+/**
+ *   \brief   Ligne d'état : deuxième chaine de NB_MATRICES_STATUT matrices sur la broche STATUT_PIN
+ *
+ *   \details Affiche la température du DHT22 en permanence. 
+ *            A définir seulement si elle est câblée, elle partage le bus SPI des matrices.
+ */ 
+// #define STATUT_PIN 4
+#define NB_MATRICES_STATUT 4
+
 /**
  *   \brief   Thermomètre type DHT 22 (AM2302)
  */ 
@@ -36,17 +57,126 @@
  */ 
 #define DHTPIN 5
 
+/**
+ *   \brief   Broche reliée à la sortie ALERT du CAP1203
+ *
+ *   \details INT6 sur le Leonardo, les broches 2 et 3 sont prises par l'I2C
+ */ 
+#define ALERT_PIN 7
+
+/**
+ *   \brief   Broche reliée à la sortie SQW/OUT du DS1307
+ *
+ *   \details INT2 sur le Leonardo (RX, Serial1 n'est pas utilisé)
+ */ 
+#define SQW_PIN 0
+
+/**
+ *   \brief   Adresse I2C du DS1307 et valeur du registre de contrôle pour SQW/OUT à 1 Hz
+ */ 
+#define DS1307_ADRESSE  0x68
+#define DS1307_CONTROLE 0x07
+#define DS1307_SQW_1HZ  0x10
+
+/**
+ *   \brief   Resynchronisation sur le DS1307 toutes les RESYNC_MINUTES minutes
+ */ 
+#define RESYNC_MINUTES 60
+
+/**
+ *   \brief   Bits des touches dans le registre SENSOR_INPUT_STATUS du CAP1203
+ */ 
+#define TOUCHE_GAUCHE 0x01
+#define TOUCHE_MILIEU 0x02
+#define TOUCHE_DROITE 0x04
+
 /**
  *   \brief   Altitude où est placé l'appareil
  *
  *   \details Permet le calcul correcte de la pression au niveau de la mer
  */ 
 #define ALTITUDE 115
+
+/**
+ *   \brief   Durée d'affichage d'une mesure en ms
+ */ 
+#define DUREE_MESURE 4000
+
+/**
+ *   \brief   Périodes des tâches en ms
+ */ 
+#define PERIODE_SQW 2000
+#define PERIODE_LUMIERE 500
+#define PERIODE_HISTORIQUE 300000
+#define PERIODE_BILAN 1000
+#define PERIODE_RAPPORT 12000
+
+/**
+ *   \brief   Baisse de la pression signalée sur l'horloge, en 1/10 hPa sur 3 h
+ *
+ *   \details Pente de l'historique ramenée à ECHANTILLONS_3H, avec au moins 3 h d'échantillons
+ */ 
+#define BAISSE_PRESSION 10
+#define ECHANTILLONS_3H (3UL * 3600000UL / PERIODE_HISTORIQUE)
+
+/**
+ *   \brief   Vitesse du port série de la télémétrie, sans effet sur l'USB CDC
+ */ 
+#define VITESSE_SERIE 115200
+
+/**
+ *   \brief   Heures de nuit, matrices éteintes de HEURE_COUCHER à HEURE_LEVER
+ */ 
+#define HEURE_COUCHER 23
+#define HEURE_LEVER   7
+
+/**
+ *   \brief   Seuils d'éclairement en lux, matrices éteintes sous LUX_NUIT, rallumées au-dessus de LUX_JOUR
+ */ 
+#define LUX_NUIT 1.0F
+#define LUX_JOUR 5.0F
+
+/**
+ *   \brief   Durée d'allumage des matrices après une touche, en ms
+ */ 
+#define DUREE_REVEIL 30000
+
+/**
+ *   \brief   Images par seconde du texte défilant
+ */ 
+#define IMAGES_DEFILEMENT 30
+
+/**
+ *   \brief   Modes d'affichage
+ */ 
+#define MODE_HORLOGE         0
+#define MODE_PRESSION        1
+#define MODE_TEMPERATURE_BMP 2
+#define MODE_TEMPERATURE_DHT 3
+#define MODE_HUMIDITE        4
+#define MODE_DEFILEMENT      5
  
+/**
+ *   \brief   Bus SPI, déclaré avant les matrices qui l'utilisent dès leur construction
+ */
+BusSpi bus;
+
 /**
  *   \brief   Matrice d'affichage
  */
-GestionMatrices matrices(LOAD_PIN);
+GestionMatrices<NB_MATRICES> matrices(bus, LOAD_PIN);
+
+#ifdef STATUT_PIN
+/**
+ *   \brief   Ligne d'état
+ */
+GestionMatrices<NB_MATRICES_STATUT> statut(bus, STATUT_PIN);
+#endif
+
+/**
+ *   \brief   Chaines de matrices, appliquées ensemble une fois par tour de boucle
+ */
+Afficheur afficheur(bus);
 
 /**
  *   \brief   structure date et heure
@@ -66,12 +196,564 @@ CAP1203 sensor;
 /**
  *   \brief   BMP180
  */ 
-Adafruit_BMP085 bmp;
+Bmp180 bmp;
 
 /**
  *   \brief   DHT22
  */ 
 DHT_Unified dht(DHTPIN, DHTTYPE);
+
+/**
+ *   \brief   Echantillonnage des BMP180 et DHT22
+ */ 
+Capteurs capteurs(bmp, dht, ALTITUDE);
+
+/**
+ *   \brief   Dernier éclairement mesuré en lux
+ */ 
+float lux = 0.0F;
+
+/**
+ *   \brief   Intensité des matrices d'après l'éclairement, avec fondu
+ */ 
+Luminosite eclairage(true);
+
+/**
+ *   \brief   Sommeil et bilan de consommation
+ */ 
+Energie energie;
+
+/**
+ *   \brief   Télémétrie sur le port série USB
+ */ 
+Telemetrie telemetrie(Serial);
+
+/**
+ *   \brief   Durée maximale d'un tour de boucle en µs et nombre de tours depuis le dernier bilan
+ */ 
+unsigned long dureeBoucle = 0;
+uint16_t tours = 0;
+
+/**
+ *   \brief   Prochain état du bilan de consommation envoyé par rapport()
+ */ 
+uint8_t etatRapport = TELEMETRIE_ETAT_ACTIF;
+
+/**
+ *   \brief   Dernière touche en ms, les matrices restent allumées DUREE_REVEIL après
+ */ 
+unsigned long reveil = 0;
+
+/**
+ *   \brief   Pièce sombre, avec hystérésis entre LUX_NUIT et LUX_JOUR
+ */ 
+bool sombre = false;
+
+/**
+ *   \brief   Historiques des mesures affichées, en 1/10 (hPa, °C)
+ *
+ *   \details 24 h de pression pour sa baisse sur l'horloge, 
+ *            la température du DHT22 pour ses extrêmes du jour dans le défilement
+ */ 
+Historique<288> historiquePression;
+Historique<128> historiqueTemperatureDht;
+
+/**
+ *   \brief   Ordonnanceur des tâches
+ */ 
+Ordonnanceur ordonnanceur;
+
+/**
+ *   \brief   Cadence du texte défilant
+ */ 
+Cadence cadence;
+
+/**
+ *   \brief   Texte défilant, "jj.mm.aaaa" puis les températures minimum et maximum du jour
+ */ 
+char date[26];
+
+/**
+ *   \brief   Heure du dernier défilement de la date, 0xFF pour défiler au démarrage
+ */ 
+uint8_t heureDate = 0xFF;
+
+/**
+ *   \brief   Mode d'affichage courant
+ */ 
+uint8_t mode = MODE_HORLOGE;
+
+/**
+ *   \brief   Tâche de fin d'affichage d'une mesure
+ */ 
+int8_t tacheFinMesure;
+
+/**
+ *   \brief   Heure logicielle, avancée par les tops du DS1307
+ */ 
+time_t maintenant;
+
+/**
+ *   \brief   Tops de seconde pas encore comptés, incrémenté par l'interruption
+ */ 
+volatile uint8_t tops = 0;
+
+/**
+ *   \brief   Un top a été reçu depuis la dernière surveillance de SQW/OUT
+ */ 
+bool sqwActif = false;
+
+/**
+ *   \brief   Alerte du CAP1203 à traiter, positionnée par l'interruption
+ */ 
+volatile bool alerte = true;
+
+/**
+ * \brief Réglage de l'intensité lumineuse des matrices avec le BH1750
+ *
+ * \details 1 lux ou moins = 0x00, 20000 lux ou plus = 0x0F, logarithmique entre les deux.
+ *          Le registre d'intensité n'est écrit que si le niveau change.
+ */
+void luminosite() {
+	lux = lightMeter.readLightLevel();
+	if(eclairage.mesure(lux)) {
+		afficheur.intensity(eclairage.niveau());
+		telemetrie.luminosite(virguleFixe(lux, 0), eclairage.niveau());
+	}
+	planifieEcran();
+}
+
+/**
+ * \brief Extinction des matrices la nuit ou dans le noir
+ *
+ * \details Seulement en mode horloge et DUREE_REVEIL après la dernière touche.
+ *          Le registre shutdown du MAX7219 garde l'image, qui continue d'être mise à jour.
+ */
+void planifieEcran() {
+	if(lux < LUX_NUIT) {
+		sombre = true;
+	} else if(lux > LUX_JOUR) {
+		sombre = false;
+	}
+	bool nuit = tm.Hour >= HEURE_COUCHER || tm.Hour < HEURE_LEVER;
+	bool eteint = (nuit || sombre) && mode == MODE_HORLOGE && millis() - reveil >= DUREE_REVEIL;
+	if(eteint != afficheur.enVeille()) {
+		telemetrie.mode(mode, !eteint);
+	}
+	afficheur.veille(eteint);
+	energie.affichage(afficheur.modules(), !eteint, eclairage.niveau());
+}
+
+/**
+ * \brief Présence de l'alimentation USB
+ *
+ * \return true si VBUS est présent, le port série doit alors rester actif
+ */
+bool usbPresent() {
+	return((USBSTA & _BV(VBUS)) != 0);
+}
+
+/**
+ * \brief Sommeil jusqu'au prochain évènement
+ *
+ * \details Rien à faire tant qu'aucune interruption ne survient. 
+ *          Power-down si les matrices sont éteintes, sans USB, en mode horloge et sans transfert en cours : 
+ *          seul le top du DS1307 réveille (INT2), une touche est vue au top suivant, 
+ *          ALERT restant à l'état bas. Sinon idle, réveillé au moins à chaque milliseconde par le Timer0.
+ */
+void sommeil() {
+	if(tops != 0 || alerte) {
+		return;
+	}
+	if(afficheur.enVeille() && mode == MODE_HORLOGE && !usbPresent() && !bus.occupe() && !bmp.occupe()) {
+		energie.dort(SOMMEIL_ARRET);
+	} else {
+		energie.dort(SOMMEIL_REPOS);
+	}
+}
+
+/**
+ * \brief Bilan de la boucle, de la latence de l'affichage et de la consommation en télémétrie, chaque seconde
+ *
+ * \details Le commit du tour précédent est en général déjà envoyé, 
+ *          latence() n'attend au plus que la fin de sa salve.
+ */
+void bilan() {
+	telemetrie.boucle(dureeBoucle, tours);
+	telemetrie.latence(afficheur.latence(), afficheur.modules());
+	telemetrie.energie(energie.charge() * 1000.0F, energie.courant() * 100.0F);
+	dureeBoucle = 0;
+	tours = 0;
+}
+
+/**
+ * \brief Une durée du bilan de consommation en télémétrie
+ *
+ * \details Temps actif, en sommeil idle et en power-down, matrices allumées et éteintes : 
+ *          la consommation par état se déduit des courants de Energie.h.
+ *          Un état par appel, chacun revient toutes les minutes sans remplir la file de la télémétrie.
+ */
+void rapport() {
+	if(etatRapport == TELEMETRIE_ETAT_ALLUMEES) {
+		telemetrie.duree(etatRapport, energie.dureeAffichage(true));
+	} else if(etatRapport == TELEMETRIE_ETAT_ETEINTES) {
+		telemetrie.duree(etatRapport, energie.dureeAffichage(false));
+	} else {
+		telemetrie.duree(etatRapport, energie.duree(etatRapport));
+	}
+	etatRapport = (etatRapport + 1) % (TELEMETRIE_ETAT_ETEINTES + 1);
+}
+
+/**
+ * \brief Changement du mode d'affichage, signalé en télémétrie
+ *
+ * \param pMode le nouveau mode
+ */
+void changeMode(uint8_t pMode) {
+	if(pMode != mode) {
+		mode = pMode;
+		telemetrie.mode(mode, !afficheur.enVeille());
+	}
+}
+
+/**
+ * \brief Echantillon d'un capteur en télémétrie, 2 décimales
+ *
+ * \param pMesure la mesure (MESURE_xxx)
+ * \param pValide false si le capteur n'a pas répondu
+ * \param pValeur la valeur lue
+ */
+void echantillon(uint8_t pMesure, bool pValide, float pValeur) {
+	telemetrie.mesure(pMesure, pValide, pValide ? virguleFixe(pValeur, 2) : 0, 2);
+#ifdef STATUT_PIN
+	if(pMesure == MESURE_TEMPERATURE_DHT) {
+		if(pValide) {
+			statut.affichageDeg(pValeur);
+		} else {
+			Disposition disposition;
+			indisponible(disposition);
+			statut.affichage(disposition);
+		}
+	}
+#endif
+}
+
+/**
+ * \brief Ecrit une température en 1/10 °C suivie du signe degré
+ *
+ * \details Bornée à ±99,9 °C, au plus 6 caractères
+ *
+ * \param pTexte la fin du texte
+ * \param pDixiemes la température en 1/10 °C
+ *
+ * \return la nouvelle fin du texte
+ */
+char *ecritDegres(char *pTexte, int32_t pDixiemes) {
+	if(pDixiemes > 999) {
+		pDixiemes = 999;
+	} else if(pDixiemes < -999) {
+		pDixiemes = -999;
+	}
+	if(pDixiemes < 0) {
+		*pTexte++ = '-';
+		pDixiemes = -pDixiemes;
+	}
+	if(pDixiemes >= 100) {
+		*pTexte++ = '0' + pDixiemes / 100;
+	}
+	*pTexte++ = '0' + pDixiemes / 10 % 10;
+	*pTexte++ = '.';
+	*pTexte++ = '0' + pDixiemes % 10;
+	*pTexte++ = '*';
+	return(pTexte);
+}
+
+/**
+ * \brief Défilement de la date
+ *
+ * \details Suivie des températures extrêmes du jour dès le premier échantillon.
+ *          Les images sont dessinées par loop() au rythme de la cadence.
+ */
+void defileDate() {
+	uint16_t annee = tmYearToCalendar(tm.Year);
+	date[0] = '0' + tm.Day / 10;
+	date[1] = '0' + tm.Day % 10;
+	date[2] = '.';
+	date[3] = '0' + tm.Month / 10;
+	date[4] = '0' + tm.Month % 10;
+	date[5] = '.';
+	date[6] = '0' + annee / 1000;
+	date[7] = '0' + annee / 100 % 10;
+	date[8] = '0' + annee / 10 % 10;
+	date[9] = '0' + annee % 10;
+	char *fin = &date[10];
+	if(historiqueTemperatureDht.extremesConnus()) {
+		*fin++ = ' ';
+		*fin++ = ' ';
+		fin = ecritDegres(fin, historiqueTemperatureDht.minimum());
+		*fin++ = ' ';
+		fin = ecritDegres(fin, historiqueTemperatureDht.maximum());
+	}
+	*fin = 0;
+
+	changeMode(MODE_DEFILEMENT);
+	matrices.texte(date);
+	cadence.demarre(IMAGES_DEFILEMENT);
+}
+
+/**
+ * \brief Image suivante du défilement, retour à l'horloge à la fin du texte
+ */
+void imageDefilement() {
+	if(!matrices.defile()) {
+		cadence.arrete();
+		changeMode(MODE_HORLOGE);
+		afficheHorloge();
+	}
+}
+
+/**
+ * \brief Lecture du DS1307, l'heure logicielle repart de sa valeur
+ */
+void resynchronise() {
+	RTC.read(tm);
+	maintenant = makeTime(tm);
+}
+
+/**
+ * \brief Interruption de SQW/OUT, une par seconde sur le front descendant
+ *
+ * \details Pas d'I2C sous interruption, le top est seulement compté
+ */
+void topSeconde() {
+	tops++;
+	energie.top();
+}
+
+/**
+ * \brief Avance l'heure logicielle des tops reçus
+ *
+ * \details L'horloge n'est redessinée qu'au changement de minute, 
+ *          juste après le front du DS1307. La resynchronisation se fait au même moment, 
+ *          quand le DS1307 vient de changer de seconde.
+ *          Chaque seconde, les deux points clignotent et la barre des secondes avance 
+ *          par le calque des matrices, quelques octets seulement.
+ */
+void secondes() {
+	if(tops == 0) {
+		return;
+	}
+	noInterrupts();
+	uint8_t nombre = tops;
+	tops = 0;
+	interrupts();
+	
+	sqwActif = true;
+	time_t precedent = maintenant;
+	maintenant += nombre;
+	matrices.deuxPoints(second(maintenant) % 2 == 0);
+	matrices.secondes(second(maintenant));
+	if(maintenant / SECS_PER_MIN == precedent / SECS_PER_MIN) {
+		breakTime(maintenant, tm);
+		return;
+	}
+	
+	if(minute(maintenant) % RESYNC_MINUTES == 0) {
+		resynchronise();
+	} else {
+		breakTime(maintenant, tm);
+	}
+	afficheHorloge();
+}
+
+/**
+ * \brief Surveillance de SQW/OUT
+ *
+ * \details Sans top depuis la dernière surveillance (sortie non câblée, DS1307 absent), 
+ *          l'heure est relue et redessinée à chaque surveillance.
+ */
+void surveilleSqw() {
+	if(!sqwActif) {
+		resynchronise();
+		afficheHorloge();
+	}
+	sqwActif = false;
+}
+
+/**
+ * \brief Affichage horloge de l'heure logicielle, seulement en mode horloge
+ *
+ * \details La date défile à chaque changement d'heure, sauf en veille : 
+ *          le défilement empêcherait le mode power-down, l'horloge est redessinée.
+ */
+void afficheHorloge() {
+	if(mode == MODE_HORLOGE) {
+		if(tm.Hour != heureDate) {
+			if(tm.Hour == 0 && heureDate != 0xFF) {
+				nouveauJour();
+			}
+			heureDate = tm.Hour;
+			if(!afficheur.enVeille()) {
+				defileDate();
+				return;
+			}
+		}
+		matrices.horloge(tm); 
+	}
+}
+
+/**
+ * \brief Echantillonnage du BMP180
+ */
+void echantillonneBmp() {
+	capteurs.echantillonneBmp();
+}
+
+/**
+ * \brief Echantillonnage du DHT22
+ */
+void echantillonneDht() {
+	capteurs.echantillonneDht();
+}
+
+/**
+ * \brief Ajoute les mesures valides aux historiques
+ *
+ * \details La baisse de la pression est mise à jour sur l'horloge par le calque, 
+ *          le minimum et le maximum repartent à minuit.
+ */
+void enregistreHistorique() {
+	if(capteurs.valide(MESURE_PRESSION)) {
+		historiquePression.ajoute(virguleFixe(capteurs.valeur(MESURE_PRESSION), 1));
+		matrices.baisse(historiquePression.nombre() >= ECHANTILLONS_3H
+		                && historiquePression.tendance() * ECHANTILLONS_3H <= -BAISSE_PRESSION);
+	}
+	if(capteurs.valide(MESURE_TEMPERATURE_DHT)) {
+		historiqueTemperatureDht.ajoute(virguleFixe(capteurs.valeur(MESURE_TEMPERATURE_DHT), 1));
+	}
+}
+
+/**
+ * \brief Nouvelle journée des historiques
+ */
+void nouveauJour() {
+	historiquePression.nouveauJour();
+	historiqueTemperatureDht.nouveauJour();
+}
+
+/**
+ * \brief Affiche une mesure pendant DUREE_MESURE
+ *
+ * \details Dernière valeur échantillonnée, sans attente de conversion.
+ *          Une mesure invalide s'affiche "----".
+ *
+ * \param pMode le mode correspondant à la mesure
+ */
+void afficheMesure(uint8_t pMode) {
+	// Une mesure interrompt le défilement
+	cadence.arrete();
+	changeMode(pMode);
+	uint8_t mesure;
+	switch(mode) {
+		case MODE_PRESSION:
+			mesure = MESURE_PRESSION;
+			break;
+		case MODE_TEMPERATURE_BMP:
+			mesure = MESURE_TEMPERATURE_BMP;
+			break;
+		case MODE_TEMPERATURE_DHT:
+			mesure = MESURE_TEMPERATURE_DHT;
+			break;
+		default:
+			mesure = MESURE_HUMIDITE;
+			break;
+	}
+	
+	if(!capteurs.valide(mesure)) {
+		Disposition disposition;
+		indisponible(disposition);
+		matrices.affichage(disposition);
+	} else if(mode == MODE_PRESSION) {
+		matrices.affichage(capteurs.valeur(mesure));
+	} else if(mode == MODE_HUMIDITE) {
+		matrices.affichagePourcent(capteurs.valeur(mesure)); 
+	} else {
+		matrices.affichageDeg(capteurs.valeur(mesure)); 
+	}
+	ordonnanceur.relance(tacheFinMesure, DUREE_MESURE);
+}
+
+/**
+ * \brief Fin d'affichage d'une mesure
+ *
+ * \details Les deux températures s'enchainent, sinon retour à l'horloge
+ */
+void finMesure() {
+	if(mode == MODE_TEMPERATURE_BMP) {
+		afficheMesure(MODE_TEMPERATURE_DHT);
+	} else {
+		changeMode(MODE_HORLOGE);
+		afficheHorloge();
+	}
+}
+
+/**
+ * \brief Interruption sur la sortie ALERT du CAP1203
+ *
+ * \details Pas d'I2C sous interruption, l'évènement est seulement noté
+ */
+void alerteTouches() {
+	alerte = true;
+}
+
+/**
+ * \brief Lecture des touches
+ *
+ * \details Un seul accès au registre d'état par alerte du CAP1203, 
+ *          qui mémorise une touche brève jusqu'à l'effacement de l'alerte.
+ *          ALERT restant à l'état bas tant que l'alerte n'est pas effacée, 
+ *          le niveau de la broche est aussi testé pour ne jamais rester bloqué.
+ *          Une touche maintenue ne relit pas la mesure déjà affichée
+ */
+void touches() {
+	if(!alerte && digitalRead(ALERT_PIN) == HIGH) {
+		return;
+	}
+	alerte = false;
+	uint8_t etat = sensor.readRegister(SENSOR_INPUT_STATUS);
+	sensor.clearInterrupt();
+	
+	// Une touche rallume les matrices
+	if(etat & (TOUCHE_GAUCHE | TOUCHE_MILIEU | TOUCHE_DROITE)) {
+		reveil = millis();
+		if(afficheur.enVeille()) {
+			telemetrie.mode(mode, true);
+		}
+		afficheur.veille(false);
+		energie.affichage(afficheur.modules(), true, eclairage.niveau());
+	}
+
+	// Pression
+	if (etat & TOUCHE_GAUCHE) {
+		if(mode != MODE_PRESSION) {
+			afficheMesure(MODE_PRESSION);
+		}
+	}
+
+	// Température
+	else if (etat & TOUCHE_MILIEU) {
+		if(mode != MODE_TEMPERATURE_BMP && mode != MODE_TEMPERATURE_DHT) {
+			afficheMesure(MODE_TEMPERATURE_BMP);
+		}
+	}
+
+	// Humidité
+	else if (etat & TOUCHE_DROITE) {
+		if(mode != MODE_HUMIDITE) {
+			afficheMesure(MODE_HUMIDITE);
+		}
+	}
+}
  
 // *****************************************
 //       ***** ***** ***** *   * *****
@@ -83,10 +765,47 @@ DHT_Unified dht(DHTPIN, DHTTYPE);
 void setup() {
 	// Initialisation des mesureur
 	// Les matrices sont initialisées dans le constructeur de la librairie
+	afficheur.ajoute(matrices);
+#ifdef STATUT_PIN
+	afficheur.ajoute(statut);
+#endif
 	lightMeter.begin();
 	sensor.begin();
-	bmp.begin();
+	// Résultat gardé par le pilote (present()) : sans réponse, Capteurs garde ses mesures invalides
+	bmp.begin(BMP180_ULTRAHAUTE);
 	dht.begin();
+	Serial.begin(VITESSE_SERIE);
+
+	// Touches sur interruption
+	sensor.setInterruptEnabled();
+	pinMode(ALERT_PIN, INPUT_PULLUP);
+	attachInterrupt(digitalPinToInterrupt(ALERT_PIN), alerteTouches, FALLING);
+
+	// Tops de seconde du DS1307, sortie à drain ouvert
+	Wire.beginTransmission(DS1307_ADRESSE);
+	Wire.write(DS1307_CONTROLE);
+	Wire.write(DS1307_SQW_1HZ);
+	Wire.endTransmission();
+	pinMode(SQW_PIN, INPUT_PULLUP);
+	attachInterrupt(digitalPinToInterrupt(SQW_PIN), topSeconde, FALLING);
+	resynchronise();
+	capteurs.observe(echantillon);
+
+	// Tâches, plus aucun delay() dans la boucle
+	ordonnanceur.periodique(luminosite, PERIODE_LUMIERE);
+	ordonnanceur.periodique(surveilleSqw, PERIODE_SQW);
+	ordonnanceur.periodique(echantillonneBmp, PERIODE_BMP);
+	ordonnanceur.periodique(echantillonneDht, PERIODE_DHT);
+	ordonnanceur.periodique(enregistreHistorique, PERIODE_HISTORIQUE);
+	ordonnanceur.periodique(bilan, PERIODE_BILAN);
+	ordonnanceur.periodique(rapport, PERIODE_RAPPORT);
+	tacheFinMesure = ordonnanceur.unique(finMesure, DUREE_MESURE);
+	ordonnanceur.arrete(tacheFinMesure);
+
+	luminosite();
+	echantillonneBmp();
+	echantillonneDht();
+	afficheHorloge();
 }
 
 // ****************************************
@@ -97,42 +816,24 @@ void setup() {
 //         ***** ***** ***** *
 // ****************************************
 void loop() {
-	// Réglage de l'intensité lumineuse des matrices avec le BH1750
-	float lux = lightMeter.readLightLevel();
-	// 0 lux = 0x00, 20000 lux ou plus = 0x0F, linéaire entre 0 et 20000, soit un pas de 1333 lux
-	uint8_t intensity = lux / 1333;
-	if(intensity > 0x0F) {
-		intensity = 0x0F;
-	}
-	matrices.intensity(intensity);
+	unsigned long debut = micros();
+	touches();
+	secondes();
+	if(mode == MODE_DEFILEMENT && cadence.image()) {
+		imageDefilement();
+	}
+	capteurs.execute();
+	ordonnanceur.execute();
+	// Une seule salve pour toutes les chaines
+	afficheur.commit();
+	telemetrie.envoie();
 	
-	// Pression
-	if (sensor.isLeftTouched() == true) {
-		matrices.affichage((float)bmp.readSealevelPressure(ALTITUDE) / 100.0F);
-		delay(4000);
+	unsigned long duree = micros() - debut;
+	if(duree > dureeBoucle) {
+		dureeBoucle = duree;
 	}
-
-	// Température
-	if (sensor.isMiddleTouched() == true) {
-		matrices.affichageDeg(bmp.readTemperature()); 
-		delay(4000);
-		
-		sensors_event_t event;
-		dht.temperature().getEvent(&event);
-		matrices.affichageDeg(event.temperature); 
-		delay(4000);
+	if(tours != 0xFFFF) {
+		tours++;
 	}
-
-	// Humidité
-	if (sensor.isRightTouched() == true) {
-		sensors_event_t event;
-		dht.humidity().getEvent(&event);
-		matrices.affichagePourcent(event.relative_humidity); 
-		delay(4000);
-	}
- 
-	// Affichage horloge DS1307
-	RTC.read(tm);
-	matrices.horloge(tm); 
-	delay(1000);
+	sommeil();
 }
@@ -0,0 +1,504 @@
+/*!
+ *   \file    compilateur.cpp
+ *   \brief   Compilateur de police : génère Chiffres.h depuis un dessin en texte
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Lit la police (chiffres.txt), dérive toutes les variantes des chiffres
+ *            et écrit sur la sortie standard un Chiffres.h avec les tables en flash
+ *            et la fonction ligneGlyphe() qui les lit.
+ *
+ *            compilateur [-c] police
+ *            -c : table compacte, seules les colonnes utilisées par la police sont gardées
+ *                 et les lignes sont empaquetées bit à bit ; les variantes sont dérivées
+ *                 à la lecture par un décalage, au prix de quelques cycles.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+/**
+ *   \brief   Lignes d'un glyphe
+ */
+#define NB_LIGNES 8
+
+/**
+ *   \brief   Nombre de chiffres de la police
+ */
+#define NB_CHIFFRES 10
+
+/**
+ *   \brief   Glyphe dessiné
+ */
+struct Glyphe {
+	std::string nom;
+	uint8_t lignes[NB_LIGNES];
+};
+
+/**
+ *   \brief   Variante dérivée des chiffres
+ *
+ *   \details decalage : colonnes vers la droite, vers la gauche si négatif.
+ *            points : lignes (bit 0 = ligne du haut) où la colonne de droite est allumée.
+ */
+struct Variante {
+	std::string nom;
+	int decalage;
+	uint8_t points;
+};
+
+// Police lue
+static std::vector<Variante> variantes;
+static std::vector<Glyphe> chiffres;
+static std::vector<Glyphe> symboles;
+
+/**
+ * \brief Arrêt sur une erreur de la police
+ *
+ * \param pNumero le numéro de ligne
+ * \param pMessage le message
+ */
+static void erreur(int pNumero, const char *pMessage)
+{
+	fprintf(stderr, "police, ligne %d : %s\n", pNumero, pMessage);
+	exit(1);
+}
+
+/**
+ * \brief Ligne de dessin : 8 caractères '#' ou '.'
+ *
+ * \param pLigne la ligne lue, sans fin de ligne
+ *
+ * \return true si c'est une ligne de dessin
+ */
+static bool dessin(const char *pLigne)
+{
+	if(strlen(pLigne) != 8) {
+		return(false);
+	}
+	for(uint8_t colonne = 0; colonne != 8; colonne++) {
+		if(pLigne[colonne] != '#' && pLigne[colonne] != '.') {
+			return(false);
+		}
+	}
+	return(true);
+}
+
+/**
+ * \brief Lecture de la police
+ *
+ * \param pFichier le fichier de la police
+ */
+static void lit(FILE *pFichier)
+{
+	char ligne[256];
+	int numero = 0;
+	Glyphe *glyphe = NULL;
+	uint8_t lignesLues = 0;
+	while(fgets(ligne, sizeof(ligne), pFichier) != NULL) {
+		numero++;
+		ligne[strcspn(ligne, "\r\n")] = 0;
+
+		// Dessin en cours
+		if(glyphe != NULL && lignesLues != NB_LIGNES) {
+			if(!dessin(ligne)) {
+				erreur(numero, "8 lignes de 8 caractères '#' ou '.' attendues");
+			}
+			uint8_t octet = 0;
+			for(uint8_t colonne = 0; colonne != 8; colonne++) {
+				if(ligne[colonne] == '#') {
+					octet |= 0x80 >> colonne;
+				}
+			}
+			glyphe->lignes[lignesLues++] = octet;
+			continue;
+		}
+
+		if(ligne[0] == '#' || ligne[0] == 0) {
+			continue;
+		}
+		char motCle[32], nom[32];
+		if(sscanf(ligne, "%31s %31s", motCle, nom) != 2) {
+			erreur(numero, "mot clé et nom attendus");
+		}
+		if(strcmp(motCle, "variante") == 0) {
+			Variante variante;
+			variante.nom = nom;
+			variante.decalage = 0;
+			variante.points = 0;
+			char *suite = strtok(ligne + strlen(motCle) + 1 + strlen(nom), " \t");
+			bool point = false;
+			while(suite != NULL) {
+				if(strcmp(suite, "decalage") == 0) {
+					suite = strtok(NULL, " \t");
+					if(suite == NULL) {
+						erreur(numero, "valeur du décalage attendue");
+					}
+					variante.decalage = atoi(suite);
+					point = false;
+				} else if(strcmp(suite, "point") == 0) {
+					point = true;
+				} else if(point && atoi(suite) >= 0 && atoi(suite) < NB_LIGNES) {
+					variante.points |= 1 << atoi(suite);
+				} else {
+					erreur(numero, "decalage <n> ou point <lignes> attendu");
+				}
+				suite = strtok(NULL, " \t");
+			}
+			if(variante.decalage <= -8 || variante.decalage >= 8) {
+				erreur(numero, "décalage entre -7 et 7 attendu");
+			}
+			variantes.push_back(variante);
+		} else if(strcmp(motCle, "chiffre") == 0) {
+			if(atoi(nom) != (int)chiffres.size() || chiffres.size() == NB_CHIFFRES) {
+				erreur(numero, "chiffres de 0 à 9 dans l'ordre attendus");
+			}
+			chiffres.push_back(Glyphe());
+			glyphe = &chiffres.back();
+			glyphe->nom = nom;
+			lignesLues = 0;
+		} else if(strcmp(motCle, "symbole") == 0) {
+			symboles.push_back(Glyphe());
+			glyphe = &symboles.back();
+			glyphe->nom = nom;
+			lignesLues = 0;
+		} else {
+			erreur(numero, "variante, chiffre ou symbole attendu");
+		}
+	}
+	if(glyphe != NULL && lignesLues != NB_LIGNES) {
+		erreur(numero, "dessin incomplet");
+	}
+	if(chiffres.size() != NB_CHIFFRES) {
+		erreur(numero, "il manque des chiffres");
+	}
+}
+
+/**
+ * \brief Ligne d'un chiffre dans une variante
+ *
+ * \param pVariante la variante, 0 pour la normale
+ * \param pGlyphe le chiffre
+ * \param pLigne la ligne
+ *
+ * \return la ligne dérivée
+ */
+static uint8_t derive(uint8_t pVariante, const Glyphe &pGlyphe, uint8_t pLigne)
+{
+	uint8_t ligne = pGlyphe.lignes[pLigne];
+	if(pVariante == 0) {
+		return(ligne);
+	}
+	const Variante &variante = variantes[pVariante - 1];
+	ligne = variante.decalage >= 0 ? ligne >> variante.decalage : ligne << -variante.decalage;
+	if(variante.points & (1 << pLigne)) {
+		ligne |= 0x01;
+	}
+	return(ligne);
+}
+
+/**
+ * \brief Ecrit une ligne de glyphe en binaire
+ *
+ * \param pOctet la ligne
+ * \param pIndentation le nombre de tabulations
+ * \param pDerniere true pour la dernière ligne, sans virgule
+ */
+static void ecritLigne(uint8_t pOctet, uint8_t pIndentation, bool pDerniere)
+{
+	for(uint8_t tabulation = 0; tabulation != pIndentation; tabulation++) {
+		putchar('\t');
+	}
+	printf("0b");
+	for(uint8_t masque = 0x80; masque != 0; masque >>= 1) {
+		putchar(pOctet & masque ? '1' : '0');
+	}
+	printf(pDerniere ? "\n" : ",\n");
+}
+
+/**
+ * \brief Entête, variantes et codes des caractères
+ *
+ * \param pSource le nom de la police
+ */
+static void ecritEntete(const char *pSource)
+{
+	printf("/*!\n"
+	       " *   \\file    Chiffres.h\n"
+	       " *   \\brief   Liste des caractères pour affichage sur les matrices\n"
+	       " *   \\author  Totof (raspberry.pi123@orange.fr)\n"
+	       " *   \\version 1.0\n"
+	       " *   \\date    25/12/2020\n"
+	       " *\n"
+	       " *   \\details Généré par polices/compilateur depuis polices/%s, ne pas modifier :\n"
+	       " *            changer la police puis make -C polices\n"
+	       " */\n"
+	       " \n"
+	       "#ifndef Chiffres_h\n"
+	       "#define Chiffres_h\n"
+	       "\n"
+	       "#include <stdint.h>\n"
+	       "#include <avr/pgmspace.h>\n"
+	       "\n", pSource);
+
+	int largeur = strlen("NB_VARIANTES");
+	for(size_t indice = 0; indice != variantes.size(); indice++) {
+		int taille = strlen("VARIANTE_") + variantes[indice].nom.size();
+		if(taille > largeur) {
+			largeur = taille;
+		}
+	}
+	printf("/**\n"
+	       " *   \\brief   Variantes des chiffres, premier indice de la table chiffres\n"
+	       " */ \n");
+	printf("#define %-*s 0\n", largeur, "VARIANTE_NORMALE");
+	for(size_t indice = 0; indice != variantes.size(); indice++) {
+		std::string nom = "VARIANTE_" + variantes[indice].nom;
+		printf("#define %-*s %u\n", largeur, nom.c_str(), (unsigned int)indice + 1);
+	}
+	printf("#define %-*s %u\n\n", largeur, "NB_VARIANTES", (unsigned int)variantes.size() + 1);
+
+	printf("/**\n"
+	       " *   \\brief   Nombre de chiffres par variante\n"
+	       " */ \n"
+	       "#define NB_CHIFFRES %u\n\n", NB_CHIFFRES);
+
+	largeur = strlen("NB_SYMBOLES");
+	for(size_t indice = 0; indice != symboles.size(); indice++) {
+		int taille = strlen("CAR_") + symboles[indice].nom.size();
+		if(taille > largeur) {
+			largeur = taille;
+		}
+	}
+	printf("/**\n"
+	       " *   \\brief   Codes des symboles, à la suite des chiffres\n"
+	       " *\n"
+	       " *   \\details CAR_VIDE n'a pas de dessin et donne une matrice éteinte\n"
+	       " */ \n");
+	for(size_t indice = 0; indice != symboles.size(); indice++) {
+		std::string nom = "CAR_" + symboles[indice].nom;
+		printf("#define %-*s %u\n", largeur, nom.c_str(), (unsigned int)(NB_CHIFFRES + indice));
+	}
+	printf("#define %-*s %u\n", largeur, "NB_SYMBOLES", (unsigned int)symboles.size());
+	printf("#define %-*s (NB_CHIFFRES + NB_SYMBOLES)\n\n", largeur, "CAR_VIDE");
+}
+
+/**
+ * \brief Tables complètes : toutes les variantes dérivées à la compilation
+ *
+ * \return la taille des tables en octets
+ */
+static unsigned int ecritTables(void)
+{
+	printf("/**\n"
+	       " *   \\brief   Chiffres de 0 à 9 dans toutes leurs variantes, en flash\n"
+	       " *\n"
+	       " *   \\details Indices : [variante][chiffre][ligne]\n"
+	       " */ \n"
+	       "const uint8_t chiffres[NB_VARIANTES][NB_CHIFFRES][%u] PROGMEM = {\n", NB_LIGNES);
+	for(uint8_t variante = 0; variante <= variantes.size(); variante++) {
+		printf("\t// Variante %s\n\t{\n", variante == 0 ? "NORMALE" : variantes[variante - 1].nom.c_str());
+		for(uint8_t chiffre = 0; chiffre != NB_CHIFFRES; chiffre++) {
+			printf("\t\t// %u\n\t\t{\n", chiffre);
+			for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+				ecritLigne(derive(variante, chiffres[chiffre], ligne), 3, ligne == NB_LIGNES - 1);
+			}
+			printf(chiffre == NB_CHIFFRES - 1 ? "\t\t}\n" : "\t\t},\n");
+		}
+		printf(variante == variantes.size() ? "\t}\n" : "\t},\n");
+	}
+	printf("};\n\n");
+
+	printf("/**\n"
+	       " *   \\brief   Symboles, indice : code du symbole - NB_CHIFFRES\n"
+	       " */ \n"
+	       "const uint8_t symboles[NB_SYMBOLES][%u] PROGMEM = {\n", NB_LIGNES);
+	for(size_t symbole = 0; symbole != symboles.size(); symbole++) {
+		printf("\t// %s\n\t{\n", symboles[symbole].nom.c_str());
+		for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+			ecritLigne(symboles[symbole].lignes[ligne], 2, ligne == NB_LIGNES - 1);
+		}
+		printf(symbole == symboles.size() - 1 ? "\t}\n" : "\t},\n");
+	}
+	printf("};\n\n");
+
+	printf("/**\n"
+	       " * \\brief Donne une ligne d'un caractère\n"
+	       " *\n"
+	       " * \\details Lecture directe dans les tables en flash, sans aiguillage.\n"
+	       " *          Un code inconnu donne une matrice éteinte.\n"
+	       " *\n"
+	       " * \\param pVariante la variante du chiffre (VARIANTE_xxx), ignorée pour les symboles\n"
+	       " * \\param pCode le chiffre (0 à 9) ou le symbole (CAR_xxx)\n"
+	       " * \\param pLigne la ligne du caractère\n"
+	       " *\n"
+	       " * \\return les pixels de la ligne, bit 7 à gauche\n"
+	       " */\n"
+	       "static inline uint8_t ligneGlyphe(uint8_t pVariante, uint8_t pCode, uint8_t pLigne)\n"
+	       "{\n"
+	       "\tif(pCode < NB_CHIFFRES) {\n"
+	       "\t\treturn(pgm_read_byte(&chiffres[pVariante][pCode][pLigne]));\n"
+	       "\t}\n"
+	       "\tif(pCode < NB_CHIFFRES + NB_SYMBOLES) {\n"
+	       "\t\treturn(pgm_read_byte(&symboles[pCode - NB_CHIFFRES][pLigne]));\n"
+	       "\t}\n"
+	       "\treturn(0x00);\n"
+	       "}\n\n");
+	return((variantes.size() + 1) * NB_CHIFFRES * NB_LIGNES + symboles.size() * NB_LIGNES);
+}
+
+/**
+ * \brief Table compacte : colonnes utiles seulement, lignes empaquetées bit à bit
+ *
+ * \details Les glyphes de base seuls sont gardés, 8 lignes de LARGEUR_POLICE bits
+ *          à la suite soit LARGEUR_POLICE octets. Les variantes sont appliquées à la lecture.
+ *
+ * \return la taille des tables en octets
+ */
+static unsigned int ecritTablesCompactes(void)
+{
+	std::vector<const Glyphe *> glyphes;
+	for(size_t indice = 0; indice != chiffres.size(); indice++) {
+		glyphes.push_back(&chiffres[indice]);
+	}
+	for(size_t indice = 0; indice != symboles.size(); indice++) {
+		glyphes.push_back(&symboles[indice]);
+	}
+
+	// Colonnes utilisées par au moins un glyphe
+	uint8_t utilisees = 0;
+	for(size_t glyphe = 0; glyphe != glyphes.size(); glyphe++) {
+		for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+			utilisees |= glyphes[glyphe]->lignes[ligne];
+		}
+	}
+	uint8_t colonne = 0;
+	while(colonne != 7 && (utilisees & (0x80 >> colonne)) == 0) {
+		colonne++;
+	}
+	uint8_t largeur = 8 - colonne;
+	while(largeur != 1 && (utilisees & (1 << (8 - colonne - largeur))) == 0) {
+		largeur--;
+	}
+
+	printf("/**\n"
+	       " *   \\brief   Police compacte : colonnes utiles et octets par glyphe\n"
+	       " *\n"
+	       " *   \\details Le glyphe occupe LARGEUR_POLICE colonnes à partir de COLONNE_POLICE (0 à gauche)\n"
+	       " */ \n"
+	       "#define POLICE_COMPACTE\n"
+	       "#define COLONNE_POLICE %u\n"
+	       "#define LARGEUR_POLICE %u\n"
+	       "#define OCTETS_GLYPHE  LARGEUR_POLICE\n\n", colonne, largeur);
+
+	printf("/**\n"
+	       " *   \\brief   Chiffres puis symboles, lignes de LARGEUR_POLICE bits à la suite, en flash\n"
+	       " *\n"
+	       " *   \\details Indices : [code][octet]\n"
+	       " */ \n"
+	       "const uint8_t police[NB_CHIFFRES + NB_SYMBOLES][OCTETS_GLYPHE] PROGMEM = {\n");
+	for(size_t glyphe = 0; glyphe != glyphes.size(); glyphe++) {
+		std::vector<uint8_t> octets(largeur, 0x00);
+		for(uint8_t ligne = 0; ligne != NB_LIGNES; ligne++) {
+			uint8_t bits = (glyphes[glyphe]->lignes[ligne] >> (8 - colonne - largeur)) & ((1 << largeur) - 1);
+			for(uint8_t bit = 0; bit != largeur; bit++) {
+				unsigned int position = ligne * largeur + bit;
+				if(bits & (1 << (largeur - 1 - bit))) {
+					octets[position / 8] |= 0x80 >> (position % 8);
+				}
+			}
+		}
+		printf("\t{");
+		for(uint8_t octet = 0; octet != largeur; octet++) {
+			printf(octet == 0 ? "0x%02X" : ", 0x%02X", octets[octet]);
+		}
+		printf(glyphe == glyphes.size() - 1 ? "}  // %s\n" : "}, // %s\n", glyphes[glyphe]->nom.c_str());
+	}
+	printf("};\n\n");
+
+	printf("/**\n"
+	       " *   \\brief   Variantes : décalage vers la droite (négatif vers la gauche) et lignes avec un point à droite\n"
+	       " */ \n"
+	       "const int8_t decalages[NB_VARIANTES] PROGMEM = {0");
+	for(size_t variante = 0; variante != variantes.size(); variante++) {
+		printf(", %d", variantes[variante].decalage);
+	}
+	printf("};\nconst uint8_t points[NB_VARIANTES] PROGMEM = {0x00");
+	for(size_t variante = 0; variante != variantes.size(); variante++) {
+		printf(", 0x%02X", variantes[variante].points);
+	}
+	printf("};\n\n");
+
+	printf("/**\n"
+	       " * \\brief Donne une ligne d'un caractère\n"
+	       " *\n"
+	       " * \\details La ligne est extraite de la table compacte puis la variante est appliquée.\n"
+	       " *          Un code inconnu donne une matrice éteinte.\n"
+	       " *\n"
+	       " * \\param pVariante la variante du chiffre (VARIANTE_xxx), ignorée pour les symboles\n"
+	       " * \\param pCode le chiffre (0 à 9) ou le symbole (CAR_xxx)\n"
+	       " * \\param pLigne la ligne du caractère\n"
+	       " *\n"
+	       " * \\return les pixels de la ligne, bit 7 à gauche\n"
+	       " */\n"
+	       "static inline uint8_t ligneGlyphe(uint8_t pVariante, uint8_t pCode, uint8_t pLigne)\n"
+	       "{\n"
+	       "\tif(pCode >= NB_CHIFFRES + NB_SYMBOLES) {\n"
+	       "\t\treturn(0x00);\n"
+	       "\t}\n"
+	       "\tuint8_t bit = pLigne * LARGEUR_POLICE;\n"
+	       "\tconst uint8_t *octet = &police[pCode][bit >> 3];\n"
+	       "\tuint16_t mot = pgm_read_byte(octet) << 8;\n"
+	       "\tif((bit & 7) + LARGEUR_POLICE > 8) {\n"
+	       "\t\tmot |= pgm_read_byte(octet + 1);\n"
+	       "\t}\n"
+	       "\tuint8_t ligne = (mot >> (16 - LARGEUR_POLICE - (bit & 7))) & ((1 << LARGEUR_POLICE) - 1);\n"
+	       "\tligne <<= 8 - COLONNE_POLICE - LARGEUR_POLICE;\n"
+	       "\tif(pCode < NB_CHIFFRES && pVariante != VARIANTE_NORMALE) {\n"
+	       "\t\tint8_t decalage = pgm_read_byte(&decalages[pVariante]);\n"
+	       "\t\tligne = decalage >= 0 ? ligne >> decalage : ligne << -decalage;\n"
+	       "\t\tif(pgm_read_byte(&points[pVariante]) & (1 << pLigne)) {\n"
+	       "\t\t\tligne |= 0x01;\n"
+	       "\t\t}\n"
+	       "\t}\n"
+	       "\treturn(ligne);\n"
+	       "}\n\n");
+	return(glyphes.size() * largeur + 2 * (variantes.size() + 1));
+}
+
+int main(int argc, char *argv[])
+{
+	bool compacte = false;
+	int option;
+	while((option = getopt(argc, argv, "c")) != -1) {
+		if(option == 'c') {
+			compacte = true;
+		} else {
+			fprintf(stderr, "usage : %s [-c] police\n", argv[0]);
+			return(2);
+		}
+	}
+	if(optind >= argc) {
+		fprintf(stderr, "usage : %s [-c] police\n", argv[0]);
+		return(2);
+	}
+	FILE *fichier = fopen(argv[optind], "r");
+	if(fichier == NULL) {
+		perror(argv[optind]);
+		return(2);
+	}
+	lit(fichier);
+	fclose(fichier);
+
+	const char *source = strrchr(argv[optind], '/');
+	ecritEntete(source != NULL ? source + 1 : argv[optind]);
+	unsigned int taille = compacte ? ecritTablesCompactes() : ecritTables();
+	printf("#endif\t//Chiffres_h\n");
+	fprintf(stderr, "%s : %u octets en flash\n", compacte ? "table compacte" : "tables complètes", taille);
+	return(0);
+}
@@ -0,0 +1,55 @@
+/*!
+ *   \file    verifie.cpp
+ *   \brief   Comparaison de la table compacte aux tables complètes
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Compilé deux fois : avec -DCOMPACTE et le Chiffres.h compact, 
+ *            puis avec le Chiffres.h complet de l'horloge et la fonction main.
+ *            Chaque ligne de chaque variante de chaque caractère doit être identique.
+ *            Code retour 1 sinon.
+ */
+
+#include <stdio.h>
+#include "Chiffres.h"
+
+#ifdef COMPACTE
+
+/**
+ * \brief Ligne d'un caractère lue dans la table compacte
+ */
+uint8_t ligneCompacte(uint8_t pVariante, uint8_t pCode, uint8_t pLigne)
+{
+	return(ligneGlyphe(pVariante, pCode, pLigne));
+}
+
+#else
+
+uint8_t ligneCompacte(uint8_t, uint8_t, uint8_t);
+
+// Pas de trace des lectures en flash ici
+void lectureFlash(void)
+{
+}
+
+int main(void)
+{
+	unsigned int differences = 0;
+	for(uint8_t variante = 0; variante != NB_VARIANTES; variante++) {
+		for(uint8_t code = 0; code <= CAR_VIDE; code++) {
+			for(uint8_t ligne = 0; ligne != 8; ligne++) {
+				uint8_t attendue = ligneGlyphe(variante, code, ligne);
+				uint8_t obtenue = ligneCompacte(variante, code, ligne);
+				if(attendue != obtenue) {
+					differences++;
+					printf("variante %u, code %u, ligne %u : 0x%02X au lieu de 0x%02X\n", variante, code, ligne, obtenue, attendue);
+				}
+			}
+		}
+	}
+	printf("%u différence(s)\n", differences);
+	return(differences == 0 ? 0 : 1);
+}
+
+#endif
@@ -0,0 +1,291 @@
+/*!
+ *   \file    ChaineMax7219.cpp
+ *   \brief   Modèle d'une chaine de MAX7219 rejouant une trace
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include "ChaineMax7219.h"
+
+/**
+ *   \brief   Police code B du décodage : segments DP a b c d e f g sur les bits 7 à 0
+ *
+ *   \details 0 à 9, '-', 'E', 'H', 'L', 'P', blanc. Le point décimal vient du bit 7 de la donnée.
+ */ 
+static const uint8_t codeB[16] = {
+	0x7E, 0x30, 0x6D, 0x79, 0x33, 0x5B, 0x5F, 0x70,
+	0x7F, 0x7B, 0x01, 0x4F, 0x37, 0x0E, 0x67, 0x00
+};
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \param pNbModules le nombre de MAX7219 chainés
+ * \param pCs la broche CS (LOAD) de la chaine
+ */
+ChaineMax7219::ChaineMax7219(uint8_t pNbModules, uint8_t pCs) : decalage(pNbModules * 2, 0x00), registres(pNbModules * NB_REGISTRES, 0x00), ecrits(pNbModules * NB_REGISTRES, false)
+{
+	nbModules = pNbModules;
+	cs = pCs;
+	orientation = ORIENTATION_NORMALE;
+	ordre = ORDRE_GAUCHE_PREMIER;
+	nbEcritures = 0;
+	nbRedondantes = 0;
+	nbTrames = 0;
+}
+
+/**
+ * \brief Câblage du panneau
+ *
+ * \details Seul l'affichage en dépend : pixel(), ascii() et pgm() donnent le panneau vu de face
+ *
+ * \param pOrientation l'orientation des matrices, ORIENTATION_xxx combinés
+ * \param pOrdre ORDRE_GAUCHE_PREMIER ou ORDRE_DROITE_PREMIER
+ */
+void ChaineMax7219::cablage(uint8_t pOrientation, uint8_t pOrdre)
+{
+	orientation = pOrientation;
+	ordre = pOrdre;
+}
+
+/**
+ * \brief Front sur une broche CS
+ *
+ * \details Le front montant de CS charge les registres à décalage des modules
+ *
+ * \param pBroche la broche
+ * \param pNiveau le nouveau niveau
+ */
+void ChaineMax7219::front(uint8_t pBroche, uint8_t pNiveau)
+{
+	if(pBroche == cs && pNiveau != 0) {
+		charge();
+	}
+}
+
+/**
+ * \brief Octet SPI
+ *
+ * \details L'octet entre dans le module 0 et pousse les autres vers le bout de la chaine. 
+ *          Le MAX7219 décale même CS haut, seul le front montant compte.
+ *
+ * \param pOctet l'octet
+ */
+void ChaineMax7219::octet(uint8_t pOctet)
+{
+	decalage.erase(decalage.begin());
+	decalage.push_back(pOctet);
+}
+
+/**
+ * \brief Chargement des registres au front montant de CS
+ *
+ * \details Une trame trop courte laisse aux modules du bout de la chaine 
+ *          des octets de la trame précédente, comme le vrai circuit.
+ *          Une écriture est redondante si le registre, déjà écrit, avait cette valeur.
+ */
+void ChaineMax7219::charge(void)
+{
+	nbTrames++;
+	for(uint8_t module = 0; module != nbModules; module++) {
+		uint8_t adresse = decalage[2 * (nbModules - 1 - module)] & 0x0F;
+		uint8_t valeur = decalage[2 * (nbModules - 1 - module) + 1];
+		if(adresse == REG_NOOP) {
+			continue;
+		}
+		nbEcritures++;
+		size_t indice = module * NB_REGISTRES + adresse;
+		if(ecrits[indice] && registres[indice] == valeur) {
+			nbRedondantes++;
+		}
+		registres[indice] = valeur;
+		ecrits[indice] = true;
+	}
+}
+
+/**
+ * \brief Rejoue une trace enregistrée
+ *
+ * \param pEvenements les évènements de la trace
+ */
+void ChaineMax7219::rejoue(const std::vector<Evenement> &pEvenements)
+{
+	for(size_t indice = 0; indice != pEvenements.size(); indice++) {
+		const Evenement &evenement = pEvenements[indice];
+		if(evenement.type == EVT_FRONT) {
+			front(evenement.broche, evenement.valeur);
+		} else if(evenement.type == EVT_OCTET) {
+			octet(evenement.valeur);
+		}
+	}
+}
+
+/**
+ * \brief Valeur d'un registre
+ *
+ * \param pModule le module, 0 au plus près de l'Arduino
+ * \param pAdresse l'adresse du registre
+ *
+ * \return la valeur
+ */
+uint8_t ChaineMax7219::registre(uint8_t pModule, uint8_t pAdresse) const
+{
+	return(registres[pModule * NB_REGISTRES + (pAdresse & 0x0F)]);
+}
+
+/**
+ * \brief Ligne affichée par un module
+ *
+ * \details Tient compte du test d'affichage, du shutdown, de la limite de balayage 
+ *          et du décodage code B
+ *
+ * \param pModule le module, 0 au plus près de l'Arduino
+ * \param pLigne le registre ligne (0 à 7)
+ *
+ * \return les pixels allumés, bit 7 à gauche en orientation normale
+ */
+uint8_t ChaineMax7219::ligne(uint8_t pModule, uint8_t pLigne) const
+{
+	if(registre(pModule, REG_TEST) & 0x01) {
+		return(0xFF);
+	}
+	if((registre(pModule, REG_SHUTDOWN) & 0x01) == 0 || pLigne > (registre(pModule, REG_BALAYAGE) & 0x07)) {
+		return(0x00);
+	}
+	uint8_t valeur = registre(pModule, REG_LIGNE_1 + pLigne);
+	if(registre(pModule, REG_DECODAGE) & (1 << pLigne)) {
+		valeur = (valeur & 0x80) | codeB[valeur & 0x0F];
+	}
+	return(valeur);
+}
+
+/**
+ * \brief Etat d'un pixel
+ *
+ * \param pX la colonne, 0 à gauche
+ * \param pY la ligne, 0 en haut
+ *
+ * \return true si le pixel est allumé
+ */
+bool ChaineMax7219::pixel(uint8_t pX, uint8_t pY) const
+{
+	uint8_t registreLigne = pY;
+	uint8_t colonne = pX % 8;
+	if(orientation & ORIENTATION_TRANSPOSEE) {
+		registreLigne = pX % 8;
+		colonne = pY;
+	}
+	if(orientation & ORIENTATION_MIROIR_H) {
+		colonne = 7 - colonne;
+	}
+	if(orientation & ORIENTATION_MIROIR_V) {
+		registreLigne = 7 - registreLigne;
+	}
+	return(ligne(position(pX / 8), registreLigne) & (0x80 >> colonne));
+}
+
+/**
+ * \brief Place d'un module du panneau dans la chaine
+ *
+ * \param pModule le module, 0 à gauche
+ *
+ * \return sa position, 0 au plus près de l'Arduino
+ */
+uint8_t ChaineMax7219::position(uint8_t pModule) const
+{
+	return(ordre == ORDRE_GAUCHE_PREMIER ? pModule : nbModules - 1 - pModule);
+}
+
+/**
+ * \brief Largeur de l'image
+ *
+ * \return le nombre de colonnes
+ */
+uint8_t ChaineMax7219::largeur(void) const
+{
+	return(nbModules * 8);
+}
+
+/**
+ * \brief Image en ASCII
+ *
+ * \details '#' allumé, '.' éteint, un espace entre les modules
+ *
+ * \param pFichier le fichier
+ */
+void ChaineMax7219::ascii(FILE *pFichier) const
+{
+	for(uint8_t y = 0; y != LIGNES_MODULE; y++) {
+		for(uint8_t x = 0; x != largeur(); x++) {
+			if(x != 0 && x % 8 == 0) {
+				fputc(' ', pFichier);
+			}
+			fputc(pixel(x, y) ? '#' : '.', pFichier);
+		}
+		fputc('\n', pFichier);
+	}
+}
+
+/**
+ * \brief Image en PGM (texte, P2)
+ *
+ * \details Niveau de gris d'un pixel allumé : intensité du module + 1, sur 16
+ *
+ * \param pFichier le fichier
+ */
+void ChaineMax7219::pgm(FILE *pFichier) const
+{
+	fprintf(pFichier, "P2\n%u %u\n16\n", largeur(), LIGNES_MODULE);
+	for(uint8_t y = 0; y != LIGNES_MODULE; y++) {
+		for(uint8_t x = 0; x != largeur(); x++) {
+			uint8_t gris = pixel(x, y) ? (registre(position(x / 8), REG_INTENSITE) & 0x0F) + 1 : 0;
+			fprintf(pFichier, x == 0 ? "%u" : " %u", gris);
+		}
+		fputc('\n', pFichier);
+	}
+}
+
+/**
+ * \brief Ecritures de registres, no-op exclus
+ *
+ * \return le nombre d'écritures
+ */
+unsigned long ChaineMax7219::ecritures(void) const
+{
+	return(nbEcritures);
+}
+
+/**
+ * \brief Ecritures qui n'ont pas changé la valeur du registre
+ *
+ * \return le nombre d'écritures redondantes
+ */
+unsigned long ChaineMax7219::redondantes(void) const
+{
+	return(nbRedondantes);
+}
+
+/**
+ * \brief Trames chargées (fronts montants de CS)
+ *
+ * \return le nombre de trames
+ */
+unsigned long ChaineMax7219::trames(void) const
+{
+	return(nbTrames);
+}
+
+/**
+ * \brief   Destructeur. 
+ *
+ * \note    Appelé automatiquement à la fin du programme
+ */
+ChaineMax7219::~ChaineMax7219(void)
+{
+}
+
+/*! \class ChaineMax7219 
+ *  \brief Registres d'une chaine de MAX7219 reconstitués depuis les fronts CS et les octets SPI, rendu ASCII ou PGM.
+ *
+ */
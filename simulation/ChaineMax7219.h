@@ -0,0 +1,90 @@
+/*!
+ *   \file    ChaineMax7219.h
+ *   \brief   Entete du modèle d'une chaine de MAX7219 rejouant une trace
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef CHAINEMAX7219_H_
+#define CHAINEMAX7219_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+#include "Trace.h"
+#include "Orientation.h"
+
+/**
+ *   \brief   Registres du MAX7219
+ */ 
+#define REG_NOOP       0x00
+#define REG_LIGNE_1    0x01
+#define REG_LIGNE_8    0x08
+#define REG_DECODAGE   0x09
+#define REG_INTENSITE  0x0A
+#define REG_BALAYAGE   0x0B
+#define REG_SHUTDOWN   0x0C
+#define REG_TEST       0x0F
+#define NB_REGISTRES   0x10
+
+/**
+ *   \brief   Lignes d'un module
+ */ 
+#define LIGNES_MODULE 8
+
+/**
+ *   \brief   Modèle d'une chaine de MAX7219 en matrices 8x8
+ *
+ *   \details Comme le MAX7219, les octets traversent la chaine quel que soit CS : 
+ *            au front montant de CS, chaque module charge les 16 bits de son registre à décalage. 
+ *            Le module 0, le plus proche de l'Arduino, reçoit les 2 derniers octets 
+ *            et est affiché à gauche, bit 7 dans la colonne de gauche.
+ *            Un autre câblage (cablage()) est affiché comme le panneau vu de face :
+ *            orientation des matrices et ordre de la chaine de Orientation.h.
+ *            Au démarrage les modules sont en shutdown, registres à zéro.
+ */ 
+class ChaineMax7219 {
+	public:
+		ChaineMax7219(uint8_t, uint8_t);
+		
+		void front(uint8_t, uint8_t);
+		void octet(uint8_t);
+		void rejoue(const std::vector<Evenement> &);
+		void cablage(uint8_t, uint8_t);
+		
+		uint8_t registre(uint8_t, uint8_t) const;
+		uint8_t ligne(uint8_t, uint8_t) const;
+		bool pixel(uint8_t, uint8_t) const;
+		uint8_t largeur(void) const;
+		
+		void ascii(FILE *) const;
+		void pgm(FILE *) const;
+		
+		unsigned long ecritures(void) const;
+		unsigned long redondantes(void) const;
+		unsigned long trames(void) const;
+		
+		virtual ~ChaineMax7219(void);
+		
+	private:
+		void charge(void);
+		uint8_t position(uint8_t) const;
+		
+		uint8_t nbModules;
+		uint8_t cs;
+		// Câblage du panneau, ORIENTATION_xxx et ORDRE_xxx
+		uint8_t orientation;
+		uint8_t ordre;
+		// Registres à décalage de la chaine, 2 octets par module, module 0 à la fin
+		std::vector<uint8_t> decalage;
+		std::vector<uint8_t> registres;
+		// Registres écrits depuis la mise sous tension, valeur connue
+		std::vector<bool> ecrits;
+		
+		unsigned long nbEcritures;
+		unsigned long nbRedondantes;
+		unsigned long nbTrames;
+};
+
+#endif
@@ -0,0 +1,145 @@
+/*!
+ *   \file    Trace.cpp
+ *   \brief   Trace des fronts CS et des octets SPI de la simulation
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include "Trace.h"
+
+Trace trace;
+
+/**
+ * \brief   Constructeur. 
+ *
+ * \details Trace vide
+ */
+Trace::Trace(void)
+{
+	efface();
+}
+
+/**
+ * \brief Enregistre un changement de niveau d'une broche
+ *
+ * \param pBroche la broche
+ * \param pNiveau le nouveau niveau (HIGH ou LOW)
+ */
+void Trace::front(uint8_t pBroche, uint8_t pNiveau)
+{
+	Evenement evenement = {EVT_FRONT, pBroche, pNiveau, 0};
+	liste.push_back(evenement);
+	fronts++;
+}
+
+/**
+ * \brief Enregistre un octet envoyé sur le bus SPI
+ *
+ * \param pOctet l'octet
+ */
+void Trace::octet(uint8_t pOctet)
+{
+	Evenement evenement = {EVT_OCTET, 0, pOctet, 0};
+	liste.push_back(evenement);
+	octets++;
+}
+
+/**
+ * \brief Enregistre le début d'une transaction SPI
+ *
+ * \param pFrequence la fréquence demandée
+ */
+void Trace::transaction(uint32_t pFrequence)
+{
+	Evenement evenement = {EVT_TRANSACTION, 0, 0, pFrequence};
+	liste.push_back(evenement);
+	transactions++;
+}
+
+/**
+ * \brief Compte une lecture d'un octet en flash (pgm_read_byte)
+ *
+ * \details Compteur seulement, pas d'évènement dans la liste
+ */
+void Trace::lecture(void)
+{
+	lectures++;
+}
+
+/**
+ * \brief Vide la trace et remet les compteurs à 0
+ */
+void Trace::efface(void)
+{
+	liste.clear();
+	octets = 0;
+	fronts = 0;
+	transactions = 0;
+	lectures = 0;
+}
+
+/**
+ * \brief Nombre d'octets SPI depuis le dernier efface()
+ */
+unsigned long Trace::nbOctets(void) const
+{
+	return(octets);
+}
+
+/**
+ * \brief Nombre de fronts depuis le dernier efface()
+ */
+unsigned long Trace::nbFronts(void) const
+{
+	return(fronts);
+}
+
+/**
+ * \brief Nombre de transactions SPI depuis le dernier efface()
+ */
+unsigned long Trace::nbTransactions(void) const
+{
+	return(transactions);
+}
+
+/**
+ * \brief Nombre de lectures en flash depuis le dernier efface()
+ */
+unsigned long Trace::nbLectures(void) const
+{
+	return(lectures);
+}
+
+/**
+ * \brief Liste des évènements depuis le dernier efface()
+ */
+const std::vector<Evenement> &Trace::evenements(void) const
+{
+	return(liste);
+}
+
+/**
+ * \brief Ecrit la trace, un évènement par ligne
+ *
+ * \details Format : "CS <broche> <niveau>", "SPI <octet hexa>", "TR <fréquence>"
+ *
+ * \param pFichier le fichier de sortie
+ */
+void Trace::ecrit(FILE *pFichier) const
+{
+	for(size_t indice = 0; indice != liste.size(); indice++) {
+		const Evenement &evenement = liste[indice];
+		switch(evenement.type) {
+			case EVT_FRONT:
+				fprintf(pFichier, "CS %u %u\n", evenement.broche, evenement.valeur);
+				break;
+			case EVT_OCTET:
+				fprintf(pFichier, "SPI %02X\n", evenement.valeur);
+				break;
+			case EVT_TRANSACTION:
+				fprintf(pFichier, "TR %lu\n", (unsigned long)evenement.frequence);
+				break;
+		}
+	}
+}
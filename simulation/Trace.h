@@ -0,0 +1,68 @@
+/*!
+ *   \file    Trace.h
+ *   \brief   Entete de la trace des fronts CS et des octets SPI de la simulation
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+/**
+ *   \brief   Types d'évènement de la trace
+ */ 
+#define EVT_FRONT       0
+#define EVT_OCTET       1
+#define EVT_TRANSACTION 2
+
+/**
+ *   \brief   Un évènement de la trace
+ *
+ *   \details Front : broche et nouveau niveau. 
+ *            Octet : valeur envoyée sur MOSI. 
+ *            Transaction : fréquence SPI demandée.
+ */ 
+struct Evenement {
+	uint8_t type;
+	uint8_t broche;
+	uint8_t valeur;
+	uint32_t frequence;
+};
+
+class Trace {
+	public:
+		Trace(void);
+		
+		void front(uint8_t, uint8_t);
+		void octet(uint8_t);
+		void transaction(uint32_t);
+		void lecture(void);
+		
+		void efface(void);
+		unsigned long nbOctets(void) const;
+		unsigned long nbFronts(void) const;
+		unsigned long nbTransactions(void) const;
+		unsigned long nbLectures(void) const;
+		const std::vector<Evenement> &evenements(void) const;
+		
+		void ecrit(FILE *) const;
+		
+	private:
+		std::vector<Evenement> liste;
+		unsigned long octets;
+		unsigned long fronts;
+		unsigned long transactions;
+		unsigned long lectures;
+};
+
+/**
+ *   \brief   Trace unique remplie par les bouchons Arduino et SPI
+ */ 
+extern Trace trace;
+
+#endif
@@ -0,0 +1,375 @@
+/*!
+ *   \file    benchmark.cpp
+ *   \brief   Mesure du coût des affichages de GestionMatrices
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Pour chaque appel : octets SPI, fronts CS, lectures de glyphes en flash,
+ *            estimation des cycles AVR de la partie affichage et latence des échanges.
+ *            Les cycles sont le temps pris au processeur, le bus travaille pendant ce temps.
+ *            La latence est la durée estimée des échanges avec les matrices,
+ *            fenêtre d'extinction d'un commit de plusieurs lignes.
+ *            Une ligne JSON par cas, comparée à ses seuils de régression, puis une ligne de totaux.
+ *            Compilé avec un autre câblage (ORIENTATION_MATRICES, ORDRE_MODULES), la conversion 
+ *            de l'image est comptée et les seuils sont ceux de ce câblage.
+ *            Code retour 1 si un seuil est dépassé.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "GestionMatrices.h"
+#include "Afficheur.h"
+#include "Trace.h"
+
+/**
+ *   \brief   Broche CS des matrices, comme dans horloge.ino
+ */ 
+#define LOAD_PIN 6
+
+/**
+ *   \brief   Broche CS de la ligne d'état, deuxième chaine des cas CAS_AFFICHEUR
+ */ 
+#define STATUT_PIN 4
+
+/**
+ *   \brief   Modèle de coût ATmega32U4 à 16 MHz
+ *
+ *   \details Le SPI de l'AVR divise F_CPU par 2, 4, 8... Les trames sont envoyées par la file
+ *            de BusSpi à FREQUENCE_SPI_FILE (1 MHz), fréquence de la trace : l'octet suivant 
+ *            n'est chargé que par l'interruption de fin du précédent. Un octet coûte au processeur
+ *            sa copie dans la file et l'interruption, et allonge la latence de sa durée
+ *            sur le bus plus l'interruption.
+ *            Les coûts fixes sont des ordres de grandeur estimés
+ *            (digitalWrite, copie d'un octet dans la file, entrée dans l'interruption SPI_STC
+ *            jusqu'à l'écriture de SPDR et sortie, lpm avec calcul d'adresse,
+ *            décalage d'un octet de l'image avec sa retenue).
+ */ 
+#define F_CPU_SIM          16000000UL
+#define SPI_DEFAUT         4000000UL
+#define CYCLES_FRONT       60
+#define CYCLES_OCTET       12
+#define CYCLES_INTERRUPTION 50
+#define CYCLES_TRANSACTION 40
+#define CYCLES_LECTURE     8
+#define CYCLES_DECALAGE    10
+
+/**
+ *   \brief   Cycles AVR de la conversion d'un module dans l'orientation des MAX7219
+ *
+ *   \details transposeOctets() : 8 lignes de 8 lsl/rol avec chargement et boucle, 
+ *            plus la lecture et l'écriture des 8 octets du module dans l'image. 
+ *            Rien n'est compilé en orientation normale.
+ */ 
+#if ORIENTATION_MATRICES == ORIENTATION_NORMALE
+#define CYCLES_ORIENTATION 0
+#else
+#define CYCLES_ORIENTATION 240
+#endif
+
+/**
+ *   \brief   Types de cas mesurés
+ */ 
+#define CAS_HORLOGE          0
+#define CAS_AFFICHAGE        1
+#define CAS_DEG              2
+#define CAS_POURCENT         3
+#define CAS_INTENSITE        4
+#define CAS_RAFRAICHISSEMENT 5
+#define CAS_TEXTE            6
+#define CAS_DEFILEMENT       7
+#define CAS_DEUX_POINTS      8
+#define CAS_SECONDES         9
+#define CAS_VEILLE           10
+#define CAS_AFFICHEUR        11
+
+/**
+ *   \brief   Texte défilant des cas CAS_DEFILEMENT
+ */ 
+#define TEXTE_DEFILANT "12:34 21.5*"
+
+/**
+ *   \brief   Un cas mesuré et ses seuils de régression
+ *
+ *   \details Pour l'horloge, valeur = heures * 100 + minutes.
+ *            Pour le défilement, valeur = nombre d'images, seuils pour l'ensemble des images.
+ *            Pour l'afficheur, l'horloge de valeur sur les matrices et valeur / 100 en degrés
+ *            sur la ligne d'état, appliquées ensemble : les seuils sont la somme des deux chaines.
+ *            Le seuil de cycles porte sur le processeur, celui de latence est en µs.
+ *            Les cas s'enchainent, chacun part de l'affichage laissé par le précédent.
+ */ 
+struct Cas {
+	uint8_t type;
+	float valeur;
+	unsigned long seuilOctets;
+	unsigned long seuilFronts;
+	unsigned long seuilLectures;
+	unsigned long seuilCycles;
+	unsigned long seuilLatence;
+};
+
+static const char *noms[] = {"horloge", "affichage", "affichageDeg", "affichagePourcent", "intensity", "forceRefresh", "texte", "defile", "deuxPoints", "secondes", "veille", "afficheur"};
+
+#if ORIENTATION_MATRICES == ORIENTATION_NORMALE && ORDRE_MODULES == ORDRE_GAUCHE_PREMIER
+static const Cas cas[] = {
+	{CAS_HORLOGE,           1234,      80,  20, 32,   6816,    990},
+	{CAS_HORLOGE,           1234,       0,   0, 32,    256,      0},
+	{CAS_HORLOGE,           1235,      80,  20, 32,   6816,    990},
+	{CAS_HORLOGE,           1259,      56,  14, 32,   4848,    693},
+	{CAS_HORLOGE,           1300,      80,  20, 32,   6816,    990},
+	{CAS_HORLOGE,           2359,      72,  18, 32,   6160,    891},
+	{CAS_HORLOGE,           0,         80,  20, 32,   6816,    990},
+	{CAS_DEUX_POINTS,       0,         16,   4,  0,   1312,    198},
+	{CAS_DEUX_POINTS,       1,         16,   4,  0,   1312,    198},
+	{CAS_SECONDES,          7,          0,   0,  0,      0,      0},
+	{CAS_SECONDES,          8,          8,   2,  0,    656,     99},
+	{CAS_SECONDES,          59,        48,  12,  0,   3936,    594},
+	{CAS_SECONDES,          0,         56,  14,  0,   4592,    693},
+	{CAS_HORLOGE,           1,         80,  20, 32,   6816,    990},
+	{CAS_AFFICHAGE,         1013.25F,  80,  20, 32,   6816,    990},
+	{CAS_AFFICHAGE,         1013.25F,   0,   0, 32,    256,      0},
+	{CAS_AFFICHAGE,         998.7F,    80,  20, 32,   6816,    990},
+	{CAS_AFFICHAGE,         12.34F,    80,  20, 32,   6816,    990},
+	{CAS_AFFICHAGE,         3.141F,    80,  20, 32,   6816,    990},
+	{CAS_DEG,               21.5F,     80,  20, 32,   6816,    990},
+	{CAS_DEG,               21.6F,     48,  12, 32,   4192,    594},
+	{CAS_DEG,               5.25F,     80,  20, 32,   6816,    990},
+	{CAS_DEG,               105.2F,    80,  20, 32,   6816,    990},
+	{CAS_DEG,               -5.25F,    80,  20, 32,   6816,    990},
+	{CAS_AFFICHAGE,         12345,     80,  20, 32,   6816,    990},
+	{CAS_POURCENT,          45.3F,     80,  20, 32,   6816,    990},
+	{CAS_POURCENT,          7.5F,      80,  20, 32,   6816,    990},
+	{CAS_POURCENT,          100.0F,    80,  20, 32,   6816,    990},
+	{CAS_INTENSITE,         0,          8,   2,  0,    656,     99},
+	{CAS_INTENSITE,         15,         8,   2,  0,    656,     99},
+	{CAS_RAFRAICHISSEMENT,  0,         64,  16,  0,   5248,    792},
+	{CAS_VEILLE,            1,          8,   2,  0,    656,     99},
+	{CAS_VEILLE,            1,          0,   0,  0,      0,      0},
+	{CAS_HORLOGE,           1234,      64,  16, 32,   5504,    792},
+	{CAS_VEILLE,            0,          8,   2,  0,    656,     99},
+	{CAS_TEXTE,             0,          0,   0,  0,      0,      0},
+	{CAS_DEFILEMENT,        1,         64,  16,  8,   5632,    792},
+	{CAS_DEFILEMENT,        32,      2048, 512, 32, 178432,  25344},
+	{CAS_DEFILEMENT,        200,     3160, 790, 24, 276272,  39105},
+	{CAS_AFFICHEUR,         1234,     160,  40, 64,  13632,   1980},
+	{CAS_AFFICHEUR,         1234,       0,   0, 64,    512,      0},
+	{CAS_AFFICHEUR,         1235,     160,  40, 64,  13632,   1980},
+	{CAS_AFFICHEUR,         2359,     160,  40, 64,  13632,   1980}
+};
+#else
+// Câblage FC-16 de make benchmark : conversion des modules comptée, moins d'octets (colonnes vides des glyphes)
+static const Cas cas[] = {
+	{CAS_HORLOGE,           1234,      80,  20, 32,   7776,    990},
+	{CAS_HORLOGE,           1234,       0,   0, 32,   1216,      0},
+	{CAS_HORLOGE,           1235,      56,  14, 32,   5808,    693},
+	{CAS_HORLOGE,           1259,      64,  16, 32,   6464,    792},
+	{CAS_HORLOGE,           1300,      72,  18, 32,   7120,    891},
+	{CAS_HORLOGE,           2359,      64,  16, 32,   6464,    792},
+	{CAS_HORLOGE,           0,         72,  18, 32,   7120,    891},
+	{CAS_DEUX_POINTS,       0,         16,   4,  0,   1792,    198},
+	{CAS_DEUX_POINTS,       1,         16,   4,  0,   1792,    198},
+	{CAS_SECONDES,          7,          0,   0,  0,      0,      0},
+	{CAS_SECONDES,          8,          8,   2,  0,    896,     99},
+	{CAS_SECONDES,          59,        48,  12,  0,   5376,    594},
+	{CAS_SECONDES,          0,         56,  14,  0,   6272,    693},
+	{CAS_HORLOGE,           1,         56,  14, 32,   5808,    693},
+	{CAS_AFFICHAGE,         1013.25F,  80,  20, 32,   7776,    990},
+	{CAS_AFFICHAGE,         1013.25F,   0,   0, 32,   1216,      0},
+	{CAS_AFFICHAGE,         998.7F,    64,  16, 32,   6464,    792},
+	{CAS_AFFICHAGE,         12.34F,    64,  16, 32,   6464,    792},
+	{CAS_AFFICHAGE,         3.141F,    64,  16, 32,   6464,    792},
+	{CAS_DEG,               21.5F,     64,  16, 32,   6464,    792},
+	{CAS_DEG,               21.6F,     32,   8, 32,   3840,    396},
+	{CAS_DEG,               5.25F,     64,  16, 32,   6464,    792},
+	{CAS_DEG,               105.2F,    64,  16, 32,   6464,    792},
+	{CAS_DEG,               -5.25F,    64,  16, 32,   6464,    792},
+	{CAS_AFFICHAGE,         12345,     64,  16, 32,   6464,    792},
+	{CAS_POURCENT,          45.3F,     72,  18, 32,   7120,    891},
+	{CAS_POURCENT,          7.5F,      64,  16, 32,   6464,    792},
+	{CAS_POURCENT,          100.0F,    64,  16, 32,   6464,    792},
+	{CAS_INTENSITE,         0,          8,   2,  0,    656,     99},
+	{CAS_INTENSITE,         15,         8,   2,  0,    656,     99},
+	{CAS_RAFRAICHISSEMENT,  0,         64,  16,  0,   6208,    792},
+	{CAS_VEILLE,            1,          8,   2,  0,    656,     99},
+	{CAS_VEILLE,            1,          0,   0,  0,      0,      0},
+	{CAS_HORLOGE,           1234,      64,  16, 32,   6464,    792},
+	{CAS_VEILLE,            0,          8,   2,  0,    656,     99},
+	{CAS_TEXTE,             0,          0,   0,  0,      0,      0},
+	{CAS_DEFILEMENT,        1,         64,  16,  8,   6592,    792},
+	{CAS_DEFILEMENT,        32,      2048, 512, 32, 209152,  25344},
+	{CAS_DEFILEMENT,        200,     2976, 744, 24, 312064,  36828},
+	{CAS_AFFICHEUR,         1234,     144,  36, 64,  14240,   1782},
+	{CAS_AFFICHEUR,         1234,       0,   0, 64,   2432,      0},
+	{CAS_AFFICHEUR,         1235,     112,  28, 64,  11616,   1386},
+	{CAS_AFFICHEUR,         2359,     128,  32, 64,  12928,   1584}
+};
+#endif
+
+/**
+ *   \brief   Coût des échanges avec les matrices, en cycles AVR
+ */ 
+struct Echanges {
+	unsigned long cycles;
+	unsigned long latence;
+};
+
+/**
+ * \brief Estimation du coût des échanges avec les matrices de la trace courante
+ *
+ * \details Les cycles sont ceux du processeur : fronts, transactions, 
+ *          copie de chaque octet dans la file et interruption qui l'envoie.
+ *          La latence va du premier front CS au dernier : les octets se suivent sur le bus,
+ *          chacun après l'interruption qui le charge, la copie dans la file ne l'allonge pas.
+ */
+static Echanges echanges(void)
+{
+	Echanges total = {0, 0};
+	unsigned long frequence = SPI_DEFAUT;
+	const std::vector<Evenement> &liste = trace.evenements();
+	for(size_t indice = 0; indice != liste.size(); indice++) {
+		switch(liste[indice].type) {
+			case EVT_FRONT:
+				total.cycles += CYCLES_FRONT;
+				total.latence += CYCLES_FRONT;
+				break;
+			case EVT_TRANSACTION:
+				// Plus grande fréquence F_CPU / 2^n inférieure ou égale à la demande
+				frequence = F_CPU_SIM / 2;
+				while(frequence > liste[indice].frequence && frequence > F_CPU_SIM / 128) {
+					frequence /= 2;
+				}
+				total.cycles += CYCLES_TRANSACTION;
+				total.latence += CYCLES_TRANSACTION;
+				break;
+			case EVT_OCTET:
+				total.cycles += CYCLES_OCTET + CYCLES_INTERRUPTION;
+				total.latence += 8 * (F_CPU_SIM / frequence) + CYCLES_INTERRUPTION;
+				break;
+		}
+	}
+	return(total);
+}
+
+/**
+ * \brief Exécute un cas sur les matrices
+ *
+ * \details Un commit convertit les 4 modules. Le calque convertit le module d'un pixel modifié, 
+ *          qui tient dans un seul registre : une conversion par trame envoyée.
+ *
+ * \return les cycles de calcul non visibles dans la trace
+ */
+static unsigned long execute(GestionMatrices<4> &pMatrices, GestionMatrices<4> &pStatut, Afficheur &pAfficheur, const Cas &pCas)
+{
+	unsigned long cycles = 0;
+	tmElements_t tm;
+	switch(pCas.type) {
+		case CAS_HORLOGE:
+			memset(&tm, 0, sizeof(tm));
+			tm.Hour = (int)pCas.valeur / 100;
+			tm.Minute = (int)pCas.valeur % 100;
+			pMatrices.horloge(tm);
+			cycles += 4 * CYCLES_ORIENTATION;
+			break;
+		case CAS_AFFICHAGE:
+			pMatrices.affichage(pCas.valeur);
+			cycles += 4 * CYCLES_ORIENTATION;
+			break;
+		case CAS_DEG:
+			pMatrices.affichageDeg(pCas.valeur);
+			cycles += 4 * CYCLES_ORIENTATION;
+			break;
+		case CAS_POURCENT:
+			pMatrices.affichagePourcent(pCas.valeur);
+			cycles += 4 * CYCLES_ORIENTATION;
+			break;
+		case CAS_INTENSITE:
+			pMatrices.intensity((uint8_t)pCas.valeur);
+			break;
+		case CAS_RAFRAICHISSEMENT:
+			pMatrices.forceRefresh();
+			cycles += 4 * CYCLES_ORIENTATION;
+			break;
+		case CAS_DEUX_POINTS:
+			pMatrices.deuxPoints(pCas.valeur != 0);
+			cycles += trace.nbFronts() / 2 * CYCLES_ORIENTATION;
+			break;
+		case CAS_SECONDES:
+			pMatrices.secondes((uint8_t)pCas.valeur);
+			cycles += trace.nbFronts() / 2 * CYCLES_ORIENTATION;
+			break;
+		case CAS_VEILLE:
+			pMatrices.veille(pCas.valeur != 0);
+			break;
+		case CAS_TEXTE:
+			pMatrices.texte(TEXTE_DEFILANT);
+			break;
+		case CAS_DEFILEMENT:
+			for(int image = 0; image != (int)pCas.valeur; image++) {
+				if(pMatrices.defile()) {
+					// Décalage des 8 lignes de 4 matrices
+					cycles += NB_LIGNES * 4 * CYCLES_DECALAGE + 4 * CYCLES_ORIENTATION;
+				}
+			}
+			break;
+		case CAS_AFFICHEUR:
+			// Les cas de l'afficheur sont les derniers, les chaines restent différées
+			if(pAfficheur.modules() == 0) {
+				pAfficheur.ajoute(pMatrices);
+				pAfficheur.ajoute(pStatut);
+			}
+			memset(&tm, 0, sizeof(tm));
+			tm.Hour = (int)pCas.valeur / 100;
+			tm.Minute = (int)pCas.valeur % 100;
+			pMatrices.horloge(tm);
+			pStatut.affichageDeg(pCas.valeur / 100.0F);
+			pAfficheur.commit();
+			cycles += 8 * CYCLES_ORIENTATION;
+			break;
+	}
+	return(cycles);
+}
+
+int main(void)
+{
+	BusSpi bus;
+	GestionMatrices<4> matrices(bus, LOAD_PIN);
+	GestionMatrices<4> statut(bus, STATUT_PIN);
+	Afficheur afficheur(bus);
+	trace.efface();
+
+	unsigned int depassements = 0;
+	unsigned long totalOctets = 0;
+	unsigned long totalCycles = 0;
+	unsigned long totalLatence = 0;
+	for(size_t indice = 0; indice != sizeof(cas) / sizeof(cas[0]); indice++) {
+		unsigned long cycles = execute(matrices, statut, afficheur, cas[indice]);
+		Echanges bus = echanges();
+		cycles += bus.cycles + trace.nbLectures() * CYCLES_LECTURE;
+		unsigned long latence = bus.latence * 1000000UL / F_CPU_SIM;
+		bool ok = trace.nbOctets() <= cas[indice].seuilOctets
+		       && trace.nbFronts() <= cas[indice].seuilFronts
+		       && trace.nbLectures() <= cas[indice].seuilLectures
+		       && cycles <= cas[indice].seuilCycles
+		       && latence <= cas[indice].seuilLatence;
+		if(!ok) {
+			depassements++;
+		}
+		totalOctets += trace.nbOctets();
+		totalCycles += cycles;
+		totalLatence += latence;
+
+		printf("{\"cas\":\"%s\",\"valeur\":%g,\"octets\":%lu,\"fronts\":%lu,\"lectures\":%lu,\"cycles\":%lu,\"latence_us\":%lu,"
+		       "\"seuils\":[%lu,%lu,%lu,%lu,%lu],\"ok\":%s}\n",
+		       noms[cas[indice].type], cas[indice].valeur,
+		       trace.nbOctets(), trace.nbFronts(), trace.nbLectures(), cycles, latence,
+		       cas[indice].seuilOctets, cas[indice].seuilFronts, cas[indice].seuilLectures, cas[indice].seuilCycles,
+		       cas[indice].seuilLatence, ok ? "true" : "false");
+		trace.efface();
+	}
+	
+	// Totaux à comparer d'un câblage à l'autre
+	printf("{\"orientation\":%u,\"ordre\":%u,\"octets\":%lu,\"cycles\":%lu,\"latence_us\":%lu,\"depassements\":%u}\n",
+	       ORIENTATION_MATRICES, ORDRE_MODULES, totalOctets, totalCycles, totalLatence, depassements);
+
+	return(depassements == 0 ? 0 : 1);
+}
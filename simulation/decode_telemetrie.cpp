@@ -0,0 +1,210 @@
+/*!
+ *   \file    decode_telemetrie.cpp
+ *   \brief   Décodeur sur PC de la télémétrie binaire de l'horloge
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Lit les paquets de Telemetrie sur le port série du Leonardo (/dev/ttyACM0), 
+ *            un pseudo-terminal ou l'entrée standard. Resynchronisation sur les octets 
+ *            de synchronisation, paquets au CRC faux rejetés, pertes comptées d'après 
+ *            les trous des numéros de séquence (paquets perdus file pleine, voir TELEMETRIE_TAILLE). 
+ *            Une ligne JSON par paquet, puis une ligne de bilan.
+ *
+ *            decode_telemetrie [-t délai_ms] [périphérique]
+ *            -t : fin après délai_ms sans octet reçu, sinon fin de fichier seulement
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "Telemetrie.h"
+
+/**
+ *   \brief   Noms des mesures, dans l'ordre des MESURE_xxx de Capteurs.h
+ */ 
+static const char *mesures[] = {"pression", "temperature_bmp", "temperature_dht", "humidite"};
+
+/**
+ *   \brief   Noms des états du bilan, dans l'ordre des TELEMETRIE_ETAT_xxx
+ */ 
+static const char *etats[] = {"actif", "repos", "arret", "matrices_allumees", "matrices_eteintes"};
+
+// Bilan du décodage
+static unsigned long paquets = 0;
+static unsigned long erreurs = 0;
+static unsigned long pertes = 0;
+static unsigned long ignores = 0;
+
+/**
+ * \brief Entier petit-boutiste du paquet
+ *
+ * \param pOctets le premier octet
+ * \param pTaille le nombre d'octets
+ *
+ * \return l'entier
+ */
+static uint32_t lit(const uint8_t *pOctets, uint8_t pTaille)
+{
+	uint32_t valeur = 0;
+	while(pTaille--) {
+		valeur = valeur << 8 | pOctets[pTaille];
+	}
+	return(valeur);
+}
+
+/**
+ * \brief Ecrit un paquet valide en JSON
+ *
+ * \param pPaquet le paquet de TELEMETRIE_TAILLE octets
+ */
+static void ecrit(const uint8_t *pPaquet)
+{
+	uint32_t date = lit(pPaquet + TELEMETRIE_DATE, 4);
+	int32_t valeur = (int32_t)lit(pPaquet + TELEMETRIE_VALEUR, 4);
+	uint16_t complement = lit(pPaquet + TELEMETRIE_COMPLEMENT, 2);
+	
+	printf("{\"seq\":%u,\"date\":%lu,", pPaquet[TELEMETRIE_SEQUENCE], (unsigned long)date);
+	switch(pPaquet[TELEMETRIE_TYPE]) {
+		case TELEMETRIE_MESURE: {
+			uint8_t mesure = complement & 0xFF;
+			uint8_t decimales = (complement >> 8) & 0x7F;
+			printf("\"type\":\"mesure\",\"mesure\":");
+			if(mesure < sizeof(mesures) / sizeof(mesures[0])) {
+				printf("\"%s\"", mesures[mesure]);
+			} else {
+				printf("%u", mesure);
+			}
+			if(complement & TELEMETRIE_INVALIDE) {
+				printf(",\"valide\":false}\n");
+			} else {
+				double diviseur = 1.0;
+				while(decimales--) {
+					diviseur *= 10.0;
+				}
+				printf(",\"valide\":true,\"valeur\":%g}\n", valeur / diviseur);
+			}
+			break;
+		}
+		case TELEMETRIE_LUMINOSITE:
+			printf("\"type\":\"luminosite\",\"lux\":%ld,\"intensite\":%u}\n", (long)valeur, complement);
+			break;
+		case TELEMETRIE_MODE:
+			printf("\"type\":\"mode\",\"mode\":%ld,\"allume\":%s}\n", (long)valeur, complement ? "true" : "false");
+			break;
+		case TELEMETRIE_BOUCLE:
+			printf("\"type\":\"boucle\",\"duree_max_us\":%lu,\"tours\":%u}\n", (unsigned long)(uint32_t)valeur, complement);
+			break;
+		case TELEMETRIE_ENERGIE:
+			printf("\"type\":\"energie\",\"charge_uAh\":%lu,\"courant_mA\":%g}\n", (unsigned long)(uint32_t)valeur, complement / 100.0);
+			break;
+		case TELEMETRIE_DUREE:
+			printf("\"type\":\"duree\",\"etat\":");
+			if(complement < sizeof(etats) / sizeof(etats[0])) {
+				printf("\"%s\"", etats[complement]);
+			} else {
+				printf("%u", complement);
+			}
+			printf(",\"duree_ms\":%lu}\n", (unsigned long)(uint32_t)valeur);
+			break;
+		case TELEMETRIE_LATENCE:
+			printf("\"type\":\"latence\",\"latence_us\":%lu,\"matrices\":%u}\n", (unsigned long)(uint32_t)valeur, complement);
+			break;
+		default:
+			printf("\"type\":%u,\"valeur\":%ld,\"complement\":%u}\n", pPaquet[TELEMETRIE_TYPE], (long)valeur, complement);
+			break;
+	}
+}
+
+/**
+ * \brief Décode les octets reçus
+ *
+ * \details Les octets non consommés restent en tête du tampon pour la lecture suivante.
+ *          Sur un CRC faux, seul le premier octet est sauté : 
+ *          un vrai paquet qui commencerait dans le paquet rejeté est retrouvé.
+ *
+ * \param pTampon les octets reçus
+ * \param pTaille le nombre d'octets
+ *
+ * \return le nombre d'octets restant en tête du tampon
+ */
+static size_t decode(uint8_t *pTampon, size_t pTaille)
+{
+	static int precedente = -1;
+	size_t position = 0;
+	while(pTaille - position >= TELEMETRIE_TAILLE) {
+		const uint8_t *paquet = pTampon + position;
+		if(paquet[0] != TELEMETRIE_SYNCHRO_1 || paquet[1] != TELEMETRIE_SYNCHRO_2) {
+			ignores++;
+			position++;
+			continue;
+		}
+		uint16_t crc = Telemetrie::crc16(paquet + TELEMETRIE_TYPE, TELEMETRIE_CRC - TELEMETRIE_TYPE);
+		if(crc != lit(paquet + TELEMETRIE_CRC, 2)) {
+			erreurs++;
+			ignores++;
+			position++;
+			continue;
+		}
+		if(precedente >= 0) {
+			pertes += (uint8_t)(paquet[TELEMETRIE_SEQUENCE] - precedente - 1);
+		}
+		precedente = paquet[TELEMETRIE_SEQUENCE];
+		paquets++;
+		ecrit(paquet);
+		position += TELEMETRIE_TAILLE;
+	}
+	memmove(pTampon, pTampon + position, pTaille - position);
+	return(pTaille - position);
+}
+
+int main(int argc, char *argv[])
+{
+	int delai = -1;
+	int option;
+	while((option = getopt(argc, argv, "t:")) != -1) {
+		if(option == 't') {
+			delai = atoi(optarg);
+		} else {
+			fprintf(stderr, "usage : %s [-t délai_ms] [périphérique]\n", argv[0]);
+			return(2);
+		}
+	}
+	
+	int fd = STDIN_FILENO;
+	if(optind < argc) {
+		fd = open(argv[optind], O_RDONLY | O_NOCTTY);
+		if(fd < 0) {
+			perror(argv[optind]);
+			return(2);
+		}
+	}
+	// Port série ou pseudo-terminal : octets bruts, sans écho ni traitement des fins de ligne
+	if(isatty(fd)) {
+		struct termios mode;
+		tcgetattr(fd, &mode);
+		cfmakeraw(&mode);
+		tcsetattr(fd, TCSANOW, &mode);
+	}
+	
+	uint8_t tampon[256];
+	size_t taille = 0;
+	struct pollfd attente = {fd, POLLIN, 0};
+	while(poll(&attente, 1, delai) > 0) {
+		ssize_t lus = read(fd, tampon + taille, sizeof(tampon) - taille);
+		// Fin de fichier, ou EIO quand l'autre côté du pseudo-terminal est fermé
+		if(lus <= 0) {
+			break;
+		}
+		taille = decode(tampon, taille + lus);
+		fflush(stdout);
+	}
+	ignores += taille;
+	
+	printf("{\"paquets\":%lu,\"erreurs_crc\":%lu,\"pertes\":%lu,\"octets_ignores\":%lu}\n", paquets, erreurs, pertes, ignores);
+	return(0);
+}
@@ -0,0 +1,333 @@
+/*!
+ *   \file    golden.cpp
+ *   \brief   Images de référence des affichages de GestionMatrices
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Chaque cas part de matrices neuves, sa trace est rejouée dans le modèle 
+ *            de la chaine de MAX7219 et l'image ASCII obtenue est comparée au fichier 
+ *            golden/<cas>.txt. Une ligne JSON par cas avec les écritures redondantes.
+ *            Les cas à deux chaines ajoutent la ligne d'état, appliquée avec les matrices
+ *            par un Afficheur : chaque chaine est rejouée depuis la même trace sur sa broche CS.
+ *            Compilé avec un autre câblage (ORIENTATION_MATRICES, ORDRE_MODULES), le modèle 
+ *            a le même câblage : le panneau vu de face doit donner les mêmes images.
+ *            Code retour 1 si une image diffère.
+ *
+ *            golden [-u] [répertoire]
+ *            -u : réécrit les images de référence
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include "Chiffres.h"
+#include "GestionMatrices.h"
+#include "Afficheur.h"
+#include "ChaineMax7219.h"
+#include "Trace.h"
+
+/**
+ *   \brief   Broche CS des matrices, comme dans horloge.ino
+ */ 
+#define LOAD_PIN 6
+
+/**
+ *   \brief   Broche CS de la ligne d'état des cas à deux chaines
+ */ 
+#define STATUT_PIN 4
+
+/**
+ *   \brief   Nombre de matrices du modèle
+ */ 
+#define NB_MATRICES 4
+
+/**
+ * \brief Construit une structure tm
+ */
+static tmElements_t heure(uint8_t pHeure, uint8_t pMinute, uint8_t pSeconde)
+{
+	tmElements_t tm;
+	memset(&tm, 0, sizeof(tm));
+	tm.Hour = pHeure;
+	tm.Minute = pMinute;
+	tm.Second = pSeconde;
+	return(tm);
+}
+
+static void horloge1234(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.horloge(heure(12, 34, 0));
+}
+
+static void horlogeDeuxPoints(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.horloge(heure(9, 5, 0));
+	pMatrices.deuxPoints(true);
+}
+
+static void horlogeSecondes(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.horloge(heure(23, 59, 0));
+	pMatrices.secondes(30);
+}
+
+static void horlogeBaisse(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.horloge(heure(20, 15, 0));
+	pMatrices.baisse(true);
+}
+
+static void affichagePression(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.affichage(1013.25F);
+}
+
+static void affichageDecimales(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.affichage(3.14159F);
+}
+
+static void affichageNegatif(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.affichage(-12.5F);
+}
+
+static void affichageTropGrand(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.affichage(123456.0F);
+}
+
+static void affichageDeg(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.affichageDeg(21.5F);
+}
+
+static void affichageDegNegatif(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.affichageDeg(-3.2F);
+}
+
+static void affichagePourcent(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.affichagePourcent(45.3F);
+}
+
+static void affichageFixe(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.affichage((int32_t)-75, 1, CAR_DEGRE);
+}
+
+static void affichageIndisponible(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	Disposition disposition;
+	indisponible(disposition);
+	pMatrices.affichage(disposition);
+}
+
+static void defilement(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.texte("17.10.2026");
+	for(uint8_t image = 0; image != 20; image++) {
+		pMatrices.defile();
+	}
+}
+
+static void veille(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.horloge(heure(12, 34, 0));
+	pMatrices.veille(true);
+}
+
+static void reveil(GestionMatrices<NB_MATRICES> &pMatrices)
+{
+	pMatrices.veille(true);
+	pMatrices.horloge(heure(12, 34, 0));
+	pMatrices.veille(false);
+}
+
+static void afficheurHorloge(GestionMatrices<NB_MATRICES> &pMatrices, GestionMatrices<NB_MATRICES> &pStatut)
+{
+	pMatrices.horloge(heure(12, 34, 0));
+	pStatut.affichageDeg(21.5F);
+}
+
+static void afficheurVeille(GestionMatrices<NB_MATRICES> &pMatrices, GestionMatrices<NB_MATRICES> &pStatut)
+{
+	pMatrices.horloge(heure(12, 34, 0));
+	pStatut.veille(true);
+	pStatut.affichagePourcent(45.3F);
+}
+
+/**
+ *   \brief   Cas d'image
+ */ 
+struct Cas {
+	const char *nom;
+	void (*dessine)(GestionMatrices<NB_MATRICES> &);
+};
+
+/**
+ *   \brief   Cas d'image à deux chaines, appliquées par un seul commit de l'afficheur
+ */ 
+struct CasDouble {
+	const char *nom;
+	void (*dessine)(GestionMatrices<NB_MATRICES> &, GestionMatrices<NB_MATRICES> &);
+};
+
+static const Cas cas[] = {
+	{"horloge_1234",           horloge1234},
+	{"horloge_deux_points",    horlogeDeuxPoints},
+	{"horloge_secondes",       horlogeSecondes},
+	{"horloge_baisse",         horlogeBaisse},
+	{"affichage_pression",     affichagePression},
+	{"affichage_decimales",    affichageDecimales},
+	{"affichage_negatif",      affichageNegatif},
+	{"affichage_trop_grand",   affichageTropGrand},
+	{"affichage_deg",          affichageDeg},
+	{"affichage_deg_negatif",  affichageDegNegatif},
+	{"affichage_pourcent",     affichagePourcent},
+	{"affichage_fixe",         affichageFixe},
+	{"affichage_indisponible", affichageIndisponible},
+	{"defilement",             defilement},
+	{"veille",                 veille},
+	{"reveil",                 reveil}
+};
+
+static const CasDouble casDoubles[] = {
+	{"afficheur_horloge",      afficheurHorloge},
+	{"afficheur_veille",       afficheurVeille}
+};
+
+/**
+ * \brief Lit un fichier en entier
+ *
+ * \param pChemin le chemin
+ * \param pContenu le contenu lu
+ *
+ * \return false si le fichier n'existe pas
+ */
+static bool lit(const std::string &pChemin, std::string &pContenu)
+{
+	FILE *fichier = fopen(pChemin.c_str(), "r");
+	if(fichier == NULL) {
+		return(false);
+	}
+	char tampon[256];
+	size_t lus;
+	pContenu.clear();
+	while((lus = fread(tampon, 1, sizeof(tampon), fichier)) != 0) {
+		pContenu.append(tampon, lus);
+	}
+	fclose(fichier);
+	return(true);
+}
+
+/**
+ * \brief Compare une image ASCII à sa référence, ou la réécrit
+ *
+ * \param pChemin le fichier de référence
+ * \param pImage l'image obtenue
+ * \param pMiseAJour true pour réécrire la référence
+ *
+ * \return false si l'image diffère ou si le fichier n'a pu être lu ou écrit
+ */
+static bool verifie(const std::string &pChemin, const char *pImage, bool pMiseAJour)
+{
+	std::string reference;
+	bool ok;
+	if(pMiseAJour) {
+		FILE *fichier = fopen(pChemin.c_str(), "w");
+		ok = fichier != NULL && fputs(pImage, fichier) >= 0;
+		if(fichier != NULL) {
+			fclose(fichier);
+		}
+	} else {
+		ok = lit(pChemin, reference) && reference == pImage;
+	}
+	if(!ok) {
+		fprintf(stderr, "%s : attendu\n%sobtenu\n%s", pChemin.c_str(), reference.c_str(), pImage);
+	}
+	return(ok);
+}
+
+int main(int argc, char *argv[])
+{
+	bool miseAJour = false;
+	int option;
+	while((option = getopt(argc, argv, "u")) != -1) {
+		if(option == 'u') {
+			miseAJour = true;
+		} else {
+			fprintf(stderr, "usage : %s [-u] [répertoire]\n", argv[0]);
+			return(2);
+		}
+	}
+	std::string repertoire = optind < argc ? argv[optind] : "golden";
+
+	unsigned int differences = 0;
+	for(size_t indice = 0; indice != sizeof(cas) / sizeof(cas[0]); indice++) {
+		trace.efface();
+		BusSpi bus;
+		GestionMatrices<NB_MATRICES> matrices(bus, LOAD_PIN);
+		cas[indice].dessine(matrices);
+		
+		ChaineMax7219 chaine(NB_MATRICES, LOAD_PIN);
+		chaine.cablage(ORIENTATION_MATRICES, ORDRE_MODULES);
+		chaine.rejoue(trace.evenements());
+		char *image = NULL;
+		size_t taille = 0;
+		FILE *memoire = open_memstream(&image, &taille);
+		chaine.ascii(memoire);
+		fclose(memoire);
+		
+		bool ok = verifie(repertoire + "/" + cas[indice].nom + ".txt", image, miseAJour);
+		if(!ok) {
+			differences++;
+		}
+		
+		printf("{\"cas\":\"%s\",\"trames\":%lu,\"ecritures\":%lu,\"redondantes\":%lu,\"ok\":%s}\n",
+		       cas[indice].nom, chaine.trames(), chaine.ecritures(), chaine.redondantes(), ok ? "true" : "false");
+		free(image);
+	}
+	
+	for(size_t indice = 0; indice != sizeof(casDoubles) / sizeof(casDoubles[0]); indice++) {
+		trace.efface();
+		BusSpi bus;
+		GestionMatrices<NB_MATRICES> matrices(bus, LOAD_PIN);
+		GestionMatrices<NB_MATRICES> statut(bus, STATUT_PIN);
+		Afficheur afficheur(bus);
+		afficheur.ajoute(matrices);
+		afficheur.ajoute(statut);
+		casDoubles[indice].dessine(matrices, statut);
+		afficheur.commit();
+		
+		// Matrices puis ligne d'état, séparées par une ligne vide
+		ChaineMax7219 chaine(NB_MATRICES, LOAD_PIN);
+		ChaineMax7219 ligneEtat(NB_MATRICES, STATUT_PIN);
+		chaine.cablage(ORIENTATION_MATRICES, ORDRE_MODULES);
+		ligneEtat.cablage(ORIENTATION_MATRICES, ORDRE_MODULES);
+		chaine.rejoue(trace.evenements());
+		ligneEtat.rejoue(trace.evenements());
+		char *image = NULL;
+		size_t taille = 0;
+		FILE *memoire = open_memstream(&image, &taille);
+		chaine.ascii(memoire);
+		fputc('\n', memoire);
+		ligneEtat.ascii(memoire);
+		fclose(memoire);
+		
+		bool ok = verifie(repertoire + "/" + casDoubles[indice].nom + ".txt", image, miseAJour);
+		if(!ok) {
+			differences++;
+		}
+		
+		printf("{\"cas\":\"%s\",\"trames\":%lu,\"ecritures\":%lu,\"redondantes\":%lu,\"ok\":%s}\n",
+		       casDoubles[indice].nom, chaine.trames() + ligneEtat.trames(), chaine.ecritures() + ligneEtat.ecritures(),
+		       chaine.redondantes() + ligneEtat.redondantes(), ok ? "true" : "false");
+		free(image);
+	}
+	
+	return(differences == 0 ? 0 : 1);
+}
@@ -0,0 +1,88 @@
+/*!
+ *   \file    rendu.cpp
+ *   \brief   Rendu de l'image d'une chaine de MAX7219 à partir d'une trace
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Lit une trace au format de Trace::ecrit (sim_horloge -t ou capture d'analyseur logique 
+ *            convertie) et la rejoue dans le modèle de la chaine. 
+ *            Ecrit l'image finale en ASCII, ou en PGM avec -p, 
+ *            et une ligne JSON de bilan sur la sortie d'erreur.
+ *
+ *            rendu [-p] [-c broche] [-n modules] [-o orientation] [-d] [trace]
+ *            -o : orientation des matrices, ORIENTATION_xxx de Orientation.h combinés (1 pour FC-16)
+ *            -d : module de droite relié à l'Arduino
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "ChaineMax7219.h"
+
+/**
+ *   \brief   Broche CS et nombre de matrices par défaut, comme dans horloge.ino
+ */ 
+#define LOAD_PIN 6
+#define NB_MATRICES 4
+
+int main(int argc, char *argv[])
+{
+	bool pgm = false;
+	uint8_t cs = LOAD_PIN;
+	uint8_t nbModules = NB_MATRICES;
+	uint8_t orientation = ORIENTATION_NORMALE;
+	uint8_t ordre = ORDRE_GAUCHE_PREMIER;
+	int option;
+	while((option = getopt(argc, argv, "pc:n:o:d")) != -1) {
+		switch(option) {
+			case 'p':
+				pgm = true;
+				break;
+			case 'c':
+				cs = atoi(optarg);
+				break;
+			case 'n':
+				nbModules = atoi(optarg);
+				break;
+			case 'o':
+				orientation = atoi(optarg);
+				break;
+			case 'd':
+				ordre = ORDRE_DROITE_PREMIER;
+				break;
+			default:
+				fprintf(stderr, "usage : %s [-p] [-c broche] [-n modules] [-o orientation] [-d] [trace]\n", argv[0]);
+				return(2);
+		}
+	}
+	
+	FILE *fichier = stdin;
+	if(optind < argc) {
+		fichier = fopen(argv[optind], "r");
+		if(fichier == NULL) {
+			perror(argv[optind]);
+			return(2);
+		}
+	}
+	
+	ChaineMax7219 chaine(nbModules, cs);
+	chaine.cablage(orientation, ordre);
+	char ligne[128];
+	unsigned int broche, niveau, octet;
+	while(fgets(ligne, sizeof(ligne), fichier) != NULL) {
+		if(sscanf(ligne, "CS %u %u", &broche, &niveau) == 2) {
+			chaine.front(broche, niveau);
+		} else if(sscanf(ligne, "SPI %x", &octet) == 1) {
+			chaine.octet(octet);
+		}
+	}
+	
+	if(pgm) {
+		chaine.pgm(stdout);
+	} else {
+		chaine.ascii(stdout);
+	}
+	fprintf(stderr, "{\"trames\":%lu,\"ecritures\":%lu,\"redondantes\":%lu}\n", chaine.trames(), chaine.ecritures(), chaine.redondantes());
+	return(0);
+}
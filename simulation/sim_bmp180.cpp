@@ -0,0 +1,276 @@
+/*!
+ *   \file    sim_bmp180.cpp
+ *   \brief   Essai du pilote Bmp180 sur un BMP180 simulé derrière le bouchon de Wire
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Le modèle répond à l'adresse BMP180_ADRESSE : identifiant, calibration,
+ *            registre de contrôle et résultat de conversion (UT, puis UP décalé selon le
+ *            suréchantillonnage). Cas essayés :
+ *            - l'exemple de la documentation du BMP180 (15,0 °C et 69964 Pa) ;
+ *            - un balayage de UT, UP et des 4 suréchantillonnages sur deux calibrations,
+ *              comparé à la compensation de la librairie Adafruit_BMP085 reprise ci-dessous ;
+ *            - un capteur absent : begin() échoue et aucun cycle ne démarre.
+ *            Une ligne JSON par cas, code retour 1 si un cas échoue.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <Wire.h>
+#include "Bmp180.h"
+
+/**
+ *   \brief   Altitude de la pression au niveau de la mer, comme dans horloge.ino
+ */
+#define ALTITUDE 115
+
+/**
+ *   \brief   Calibration du BMP180, dans l'ordre de son EEPROM (0xAA à 0xBF)
+ */
+struct Calibration {
+	int16_t ac1, ac2, ac3;
+	uint16_t ac4, ac5, ac6;
+	int16_t b1, b2, mb, mc, md;
+};
+
+/**
+ *   \brief   Calibrations essayées : exemple de la documentation, puis un capteur réel
+ */
+static const Calibration calibrations[] = {
+	{408, -72, -14383, 32741, 32757, 23153, 6190, 4, -32768, -8711, 2868},
+	{7911, -934, -14306, 31567, 25671, 18974, 5498, 46, -32768, -11075, 2432}
+};
+
+// BMP180 simulé
+static bool present = true;
+static uint8_t registres[256];
+static uint8_t pointeur = 0;
+static uint8_t octetsEcrits = 0;
+static uint8_t aLire = 0;
+static int32_t utSimule = 0;
+static int32_t upSimule = 0;
+
+TwoWire Wire;
+
+/**
+ * \brief Charge une calibration dans l'EEPROM simulée, poids fort en premier
+ *
+ * \param pCalibration la calibration
+ */
+static void calibre(const Calibration &pCalibration)
+{
+	const int32_t mots[] = {pCalibration.ac1, pCalibration.ac2, pCalibration.ac3,
+	                        pCalibration.ac4, pCalibration.ac5, pCalibration.ac6,
+	                        pCalibration.b1, pCalibration.b2, pCalibration.mb, pCalibration.mc, pCalibration.md};
+	memset(registres, 0x00, sizeof(registres));
+	registres[0xD0] = BMP180_ID;
+	for(uint8_t mot = 0; mot != sizeof(mots) / sizeof(mots[0]); mot++) {
+		registres[0xAA + 2 * mot] = (uint16_t)mots[mot] >> 8;
+		registres[0xAA + 2 * mot + 1] = (uint16_t)mots[mot] & 0xFF;
+	}
+}
+
+/**
+ * \brief Ecriture du registre de contrôle : le résultat est prêt aussitôt
+ *
+ * \param pCommande 0x2E pour la température, 0x34 + (suréchantillonnage << 6) pour la pression
+ */
+static void conversion(uint8_t pCommande)
+{
+	if(pCommande == 0x2E) {
+		registres[0xF6] = utSimule >> 8;
+		registres[0xF7] = utSimule & 0xFF;
+		return;
+	}
+	uint32_t brut = (uint32_t)upSimule << (8 - (pCommande >> 6));
+	registres[0xF6] = brut >> 16;
+	registres[0xF7] = brut >> 8;
+	registres[0xF8] = brut;
+}
+
+void TwoWire::begin(void)
+{
+}
+
+void TwoWire::beginTransmission(uint8_t pAdresse)
+{
+	octetsEcrits = 0;
+}
+
+/**
+ * \brief Premier octet : adresse du registre, les suivants y sont écrits
+ */
+size_t TwoWire::write(uint8_t pOctet)
+{
+	if(octetsEcrits++ == 0) {
+		pointeur = pOctet;
+		return(1);
+	}
+	registres[pointeur] = pOctet;
+	if(pointeur == 0xF4) {
+		conversion(pOctet);
+	}
+	pointeur++;
+	return(1);
+}
+
+/**
+ * \return 0 si le capteur a acquitté, 2 (NACK sur l'adresse) s'il est absent
+ */
+uint8_t TwoWire::endTransmission(void)
+{
+	return(present ? 0 : 2);
+}
+
+uint8_t TwoWire::requestFrom(uint8_t pAdresse, uint8_t pNombre)
+{
+	aLire = present && pAdresse == BMP180_ADRESSE ? pNombre : 0;
+	return(aLire);
+}
+
+int TwoWire::available(void)
+{
+	return(aLire);
+}
+
+/**
+ * \return l'octet suivant, -1 si rien n'a été reçu
+ */
+int TwoWire::read(void)
+{
+	if(aLire == 0) {
+		return(-1);
+	}
+	aLire--;
+	return(registres[pointeur++]);
+}
+
+/**
+ * \brief Paramètre B5, computeB5() de la librairie Adafruit_BMP085
+ */
+static int32_t referenceB5(const Calibration &pCal, int32_t pUt)
+{
+	int32_t x1 = (pUt - (int32_t)pCal.ac6) * ((int32_t)pCal.ac5) >> 15;
+	int32_t x2 = ((int32_t)pCal.mc << 11) / (x1 + (int32_t)pCal.md);
+	return(x1 + x2);
+}
+
+/**
+ * \brief Température en °C, readTemperature() de la librairie Adafruit_BMP085
+ */
+static float referenceTemperature(const Calibration &pCal, int32_t pUt)
+{
+	float temperature = (referenceB5(pCal, pUt) + 8) >> 4;
+	return(temperature / 10);
+}
+
+/**
+ * \brief Pression en Pa, readPressure() de la librairie Adafruit_BMP085
+ */
+static int32_t referencePression(const Calibration &pCal, int32_t pUt, int32_t pUp, uint8_t pMode)
+{
+	int32_t b6 = referenceB5(pCal, pUt) - 4000;
+	int32_t x1 = ((int32_t)pCal.b2 * ((b6 * b6) >> 12)) >> 11;
+	int32_t x2 = ((int32_t)pCal.ac2 * b6) >> 11;
+	int32_t x3 = x1 + x2;
+	int32_t b3 = ((((int32_t)pCal.ac1 * 4 + x3) << pMode) + 2) / 4;
+
+	x1 = ((int32_t)pCal.ac3 * b6) >> 13;
+	x2 = ((int32_t)pCal.b1 * ((b6 * b6) >> 12)) >> 16;
+	x3 = ((x1 + x2) + 2) >> 2;
+	uint32_t b4 = ((uint32_t)pCal.ac4 * (uint32_t)(x3 + 32768)) >> 15;
+	uint32_t b7 = ((uint32_t)pUp - b3) * (uint32_t)(50000UL >> pMode);
+
+	int32_t p;
+	if(b7 < 0x80000000) {
+		p = (b7 * 2) / b4;
+	} else {
+		p = (b7 / b4) * 2;
+	}
+	x1 = (p >> 8) * (p >> 8);
+	x1 = (x1 * 3038) >> 16;
+	x2 = (-7357 * p) >> 16;
+	return(p + ((x1 + x2 + (int32_t)3791) >> 4));
+}
+
+/**
+ * \brief Un cycle complet du pilote sur les valeurs brutes simulées
+ *
+ * \param pBmp le pilote, initialisé
+ * \param pUt la température brute
+ * \param pUp la pression brute, sur 16 + suréchantillonnage bits
+ *
+ * \return false si le cycle ne se termine pas
+ */
+static bool cycle(Bmp180 &pBmp, int32_t pUt, int32_t pUp)
+{
+	utSimule = pUt;
+	upSimule = pUp;
+	pBmp.demarre();
+	for(uint8_t attente = 0; attente != 100; attente++) {
+		delay(1);
+		if(pBmp.collecte()) {
+			return(true);
+		}
+	}
+	return(false);
+}
+
+int main(void)
+{
+	unsigned int echecs = 0;
+
+	// Exemple de la documentation : UT = 27898, UP = 23843, suréchantillonnage 0
+	present = true;
+	calibre(calibrations[0]);
+	Bmp180 bmp;
+	bool ok = bmp.begin(BMP180_ULTRABASSE) && bmp.present() && cycle(bmp, 27898, 23843)
+	       && bmp.temperature() == 15.0F && bmp.pression() == 69964;
+	printf("{\"cas\":\"documentation\",\"temperature\":%g,\"pression\":%ld,\"ok\":%s}\n",
+	       bmp.temperature(), (long)bmp.pression(), ok ? "true" : "false");
+	echecs += !ok;
+
+	// Balayage comparé à la librairie Adafruit_BMP085
+	unsigned long mesures = 0;
+	unsigned long ecarts = 0;
+	for(uint8_t indice = 0; indice != sizeof(calibrations) / sizeof(calibrations[0]); indice++) {
+		const Calibration &cal = calibrations[indice];
+		calibre(cal);
+		for(uint8_t mode = BMP180_ULTRABASSE; mode <= BMP180_ULTRAHAUTE; mode++) {
+			Bmp180 capteur;
+			if(!capteur.begin(mode)) {
+				ecarts++;
+				continue;
+			}
+			for(int32_t ut = 20000; ut <= 36000; ut += 1000) {
+				for(int32_t up = 20000; up <= 45000; up += 2500) {
+					int32_t upMode = up << mode;
+					mesures++;
+					if(!cycle(capteur, ut, upMode)
+					   || capteur.temperature() != referenceTemperature(cal, ut)
+					   || capteur.pression() != referencePression(cal, ut, upMode, mode)
+					   || capteur.pressionMer(ALTITUDE) != (int32_t)(referencePression(cal, ut, upMode, mode) / pow(1.0 - ALTITUDE / 44330.0F, 5.255))) {
+						ecarts++;
+					}
+				}
+			}
+		}
+	}
+	ok = mesures != 0 && ecarts == 0;
+	printf("{\"cas\":\"adafruit\",\"mesures\":%lu,\"ecarts\":%lu,\"ok\":%s}\n", mesures, ecarts, ok ? "true" : "false");
+	echecs += !ok;
+
+	// Capteur absent : pas de calibration, aucun cycle
+	present = false;
+	Bmp180 absent;
+	bool initialise = absent.begin(BMP180_ULTRAHAUTE);
+	absent.demarre();
+	delay(100);
+	ok = !initialise && !absent.present() && !absent.occupe() && !absent.collecte();
+	printf("{\"cas\":\"absent\",\"begin\":%s,\"ok\":%s}\n", initialise ? "true" : "false", ok ? "true" : "false");
+	echecs += !ok;
+
+	return(echecs == 0 ? 0 : 1);
+}
@@ -0,0 +1,242 @@
+/*!
+ *   \file    sim_historique.cpp
+ *   \brief   Essai de l'historique compact comparé à une fenêtre recalculée en entier
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details La référence garde les échantillons en clair et applique la même règle d'oubli :
+ *            au plus NB_ECHANTILLONS_MAX, et les écarts codés (zigzag puis varint)
+ *            doivent tenir dans TAILLE octets. Après chaque ajout, nombre, dernier, moyenne,
+ *            tendance (moindres carrés en double) et extrêmes du jour sont comparés.
+ *            Cas essayés :
+ *            - vide : tout vaut 0 ;
+ *            - nombre : écarts d'un octet, la limite de NB_ECHANTILLONS_MAX oublie ;
+ *            - octets : écarts de 5 octets (±3.10^8), la place du tampon oublie ;
+ *            - aleatoire : écarts de 1 à 4 octets des deux signes, remise à zéro du jour en cours de route ;
+ *            - jour : nouveauJour() oublie les extrêmes mais pas la fenêtre.
+ *            Une ligne JSON par cas, code retour 1 si un cas échoue.
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <deque>
+#include "Historique.h"
+
+/**
+ *   \brief   Historique de référence, échantillons en clair
+ */
+struct Reference {
+	std::deque<int32_t> valeurs;
+	bool extremes;
+	int32_t min;
+	int32_t max;
+};
+
+/**
+ * \brief Octets de l'écart codé en zigzag puis varint
+ */
+static uint8_t octets(int32_t pEcart)
+{
+	uint32_t code = ((uint32_t)pEcart << 1) ^ (uint32_t)(pEcart >> 31);
+	uint8_t longueur = 1;
+	while(code >= 0x80) {
+		code >>= 7;
+		longueur++;
+	}
+	return(longueur);
+}
+
+/**
+ * \brief Ajout dans la référence, avec la règle d'oubli de l'historique
+ */
+static void ajoute(Reference &pReference, int32_t pValeur, uint16_t pTaille)
+{
+	std::deque<int32_t> &valeurs = pReference.valeurs;
+	if(valeurs.size() == NB_ECHANTILLONS_MAX) {
+		valeurs.pop_front();
+	}
+	if(!valeurs.empty()) {
+		uint16_t longueur = octets(pValeur - valeurs.back());
+		for(;;) {
+			uint16_t occupe = 0;
+			for(size_t rang = 1; rang < valeurs.size(); rang++) {
+				occupe += octets(valeurs[rang] - valeurs[rang - 1]);
+			}
+			if(occupe + longueur <= pTaille) {
+				break;
+			}
+			valeurs.pop_front();
+		}
+	}
+	valeurs.push_back(pValeur);
+	if(!pReference.extremes || pValeur < pReference.min) {
+		pReference.min = pValeur;
+	}
+	if(!pReference.extremes || pValeur > pReference.max) {
+		pReference.max = pValeur;
+	}
+	pReference.extremes = true;
+}
+
+/**
+ * \brief Compare l'historique à la référence
+ *
+ * \return false au premier écart
+ */
+template<uint16_t TAILLE>
+static bool compare(Historique<TAILLE> &pHistorique, const Reference &pReference)
+{
+	const std::deque<int32_t> &valeurs = pReference.valeurs;
+	size_t n = valeurs.size();
+	if(pHistorique.nombre() != n || pHistorique.extremesConnus() != pReference.extremes) {
+		return(false);
+	}
+	if(pReference.extremes && (pHistorique.minimum() != pReference.min || pHistorique.maximum() != pReference.max)) {
+		return(false);
+	}
+	if(!pReference.extremes && (pHistorique.minimum() != 0 || pHistorique.maximum() != 0)) {
+		return(false);
+	}
+	if(n == 0) {
+		return(pHistorique.dernier() == 0 && pHistorique.moyenne() == 0.0F && pHistorique.tendance() == 0.0F);
+	}
+	if(pHistorique.dernier() != valeurs.back()) {
+		return(false);
+	}
+
+	double somme = 0.0;
+	for(size_t rang = 0; rang != n; rang++) {
+		somme += valeurs[rang];
+	}
+	double moyenne = somme / n;
+	if(fabs(pHistorique.moyenne() - moyenne) > 1e-6 * fabs(moyenne) + 1e-3) {
+		return(false);
+	}
+
+	double pente = 0.0;
+	if(n >= 2) {
+		double moyenneX = (n - 1) / 2.0;
+		double covariance = 0.0;
+		double variance = 0.0;
+		for(size_t rang = 0; rang != n; rang++) {
+			covariance += (rang - moyenneX) * (valeurs[rang] - moyenne);
+			variance += (rang - moyenneX) * (rang - moyenneX);
+		}
+		pente = covariance / variance;
+	}
+	return(fabs(pHistorique.tendance() - pente) <= 1e-5 * fabs(pente) + 1e-5);
+}
+
+/**
+ * \brief Pseudo-aléatoire reproductible (générateur congruentiel)
+ */
+static uint32_t aleatoire(void)
+{
+	static uint32_t etat = 12345;
+	etat = etat * 1103515245UL + 12345UL;
+	return(etat >> 8);
+}
+
+/**
+ * \brief Affiche le résultat d'un cas
+ *
+ * \return 1 si le cas échoue
+ */
+static unsigned int resultat(const char *pCas, unsigned long pAjouts, unsigned int pNombre, bool pOk)
+{
+	printf("{\"cas\":\"%s\",\"ajouts\":%lu,\"nombre\":%u,\"ok\":%s}\n", pCas, pAjouts, pNombre, pOk ? "true" : "false");
+	return(pOk ? 0 : 1);
+}
+
+int main(void)
+{
+	unsigned int echecs = 0;
+
+	// Vide
+	{
+		Historique<128> historique;
+		Reference reference = {std::deque<int32_t>(), false, 0, 0};
+		echecs += resultat("vide", 0, historique.nombre(), compare(historique, reference));
+	}
+
+	// Limite du nombre d'échantillons : pression en 1/10 hPa, écarts d'un octet
+	{
+		Historique<288> historique;
+		Reference reference = {std::deque<int32_t>(), false, 0, 0};
+		bool ok = true;
+		unsigned long ajouts;
+		for(ajouts = 0; ajouts != 1000; ajouts++) {
+			int32_t valeur = 10130 + (int32_t)(ajouts % 50) - 25;
+			historique.ajoute(valeur);
+			ajoute(reference, valeur, 288);
+			ok = ok && compare(historique, reference);
+		}
+		ok = ok && historique.nombre() == NB_ECHANTILLONS_MAX;
+		echecs += resultat("nombre", ajouts, historique.nombre(), ok);
+	}
+
+	// Limite des octets : écarts de ±6.10^8, 5 octets chacun
+	{
+		Historique<128> historique;
+		Reference reference = {std::deque<int32_t>(), false, 0, 0};
+		bool ok = true;
+		unsigned long ajouts;
+		for(ajouts = 0; ajouts != 200; ajouts++) {
+			int32_t valeur = ajouts % 2 == 0 ? -300000000L : 300000000L;
+			historique.ajoute(valeur);
+			ajoute(reference, valeur, 128);
+			ok = ok && compare(historique, reference);
+		}
+		ok = ok && octets(600000000L) == OCTETS_ECART_MAX && historique.nombre() == 1 + 128 / OCTETS_ECART_MAX;
+		echecs += resultat("octets", ajouts, historique.nombre(), ok);
+	}
+
+	// Ecarts de 1 à 4 octets des deux signes, nouveau jour tous les 500 ajouts
+	{
+		Historique<128> historique;
+		Reference reference = {std::deque<int32_t>(), false, 0, 0};
+		bool ok = true;
+		int32_t valeur = 0;
+		unsigned long ajouts;
+		for(ajouts = 0; ajouts != 5000; ajouts++) {
+			// Amplitude de l'écart : 2^6, 2^13, 2^20 ou 2^23
+			static const uint8_t bits[] = {6, 13, 20, 23};
+			int32_t amplitude = (int32_t)1 << bits[aleatoire() % 4];
+			valeur += (int32_t)(aleatoire() % (2 * amplitude)) - amplitude;
+			// Valeurs bornées : la somme de 288 échantillons tient sur 32 bits
+			if(valeur > 7000000L || valeur < -7000000L) {
+				valeur /= 2;
+			}
+			historique.ajoute(valeur);
+			ajoute(reference, valeur, 128);
+			if(ajouts % 500 == 499) {
+				historique.nouveauJour();
+				reference.extremes = false;
+			}
+			ok = ok && compare(historique, reference);
+		}
+		echecs += resultat("aleatoire", ajouts, historique.nombre(), ok);
+	}
+
+	// Nouveau jour : extrêmes oubliés, la fenêtre reste
+	{
+		Historique<288> historique;
+		Reference reference = {std::deque<int32_t>(), false, 0, 0};
+		static const int32_t valeurs[] = {215, 198, 250, 231};
+		for(uint8_t rang = 0; rang != sizeof(valeurs) / sizeof(valeurs[0]); rang++) {
+			historique.ajoute(valeurs[rang]);
+			ajoute(reference, valeurs[rang], 288);
+		}
+		bool ok = compare(historique, reference) && historique.minimum() == 198 && historique.maximum() == 250;
+		historique.nouveauJour();
+		reference.extremes = false;
+		ok = ok && compare(historique, reference) && historique.nombre() == 4;
+		historique.ajoute(222);
+		ajoute(reference, 222, 288);
+		ok = ok && compare(historique, reference) && historique.minimum() == 222 && historique.maximum() == 222;
+		echecs += resultat("jour", 5, historique.nombre(), ok);
+	}
+
+	return(echecs == 0 ? 0 : 1);
+}
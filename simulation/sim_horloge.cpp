@@ -0,0 +1,86 @@
+/*!
+ *   \file    sim_horloge.cpp
+ *   \brief   Simulation sur PC de l'affichage de l'horloge
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Enchaine les affichages du montage horloge et donne pour chacun
+ *            le nombre d'octets SPI, de fronts CS et de transactions.
+ *            Option -t : écrit aussi la trace complète de chaque étape.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "GestionMatrices.h"
+#include "Trace.h"
+
+/**
+ *   \brief   Broche CS des matrices, comme dans horloge.ino
+ */ 
+#define LOAD_PIN 6
+
+// Ecriture de la trace complète
+static bool traceComplete = false;
+
+/**
+ * \brief Affiche le bilan d'une étape et vide la trace
+ *
+ * \param pEtape le nom de l'étape
+ */
+static void bilan(const char *pEtape)
+{
+	printf("%-28s octets=%4lu fronts=%3lu transactions=%3lu\n", pEtape, trace.nbOctets(), trace.nbFronts(), trace.nbTransactions());
+	if(traceComplete) {
+		trace.ecrit(stdout);
+	}
+	trace.efface();
+}
+
+/**
+ * \brief Construit une structure tm
+ */
+static tmElements_t heure(uint8_t pHeure, uint8_t pMinute, uint8_t pSeconde)
+{
+	tmElements_t tm;
+	memset(&tm, 0, sizeof(tm));
+	tm.Hour = pHeure;
+	tm.Minute = pMinute;
+	tm.Second = pSeconde;
+	return(tm);
+}
+
+int main(int argc, char *argv[])
+{
+	traceComplete = argc > 1 && strcmp(argv[1], "-t") == 0;
+
+	BusSpi bus;
+	GestionMatrices<4> matrices(bus, LOAD_PIN);
+	bilan("initialisation");
+
+	matrices.horloge(heure(12, 34, 0));
+	bilan("horloge 12:34");
+	matrices.horloge(heure(12, 34, 1));
+	bilan("horloge 12:34 (inchangee)");
+	matrices.horloge(heure(12, 35, 0));
+	bilan("horloge 12:35");
+	matrices.horloge(heure(23, 59, 0));
+	bilan("horloge 23:59");
+
+	matrices.affichage(1013.25F);
+	bilan("affichage 1013.25");
+	matrices.affichage(3.14159F);
+	bilan("affichage 3.14159");
+	matrices.affichageDeg(21.5F);
+	bilan("affichageDeg 21.5");
+	matrices.affichagePourcent(45.3F);
+	bilan("affichagePourcent 45.3");
+
+	matrices.intensity(0x05);
+	bilan("intensity 5");
+
+	matrices.forceRefresh();
+	bilan("forceRefresh");
+
+	return(0);
+}
@@ -0,0 +1,47 @@
+/*!
+ *   \file    sim_max7221.cpp
+ *   \brief   Simulation sur PC du croquis MAX7221
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Appelle setup() puis quelques loop() du croquis et donne pour chacun
+ *            le nombre d'octets SPI et de fronts CS.
+ *            Option -t : écrit aussi la trace complète de chaque étape.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "Trace.h"
+
+/**
+ *   \brief   Nombre de tours de loop() simulés
+ */ 
+#define NB_TOURS 3
+
+// Fonctions du croquis MAX7221.ino
+void setup(void);
+void loop(void);
+
+int main(int argc, char *argv[])
+{
+	bool traceComplete = argc > 1 && strcmp(argv[1], "-t") == 0;
+
+	setup();
+	printf("%-12s octets=%4lu fronts=%3lu\n", "setup", trace.nbOctets(), trace.nbFronts());
+	if(traceComplete) {
+		trace.ecrit(stdout);
+	}
+	trace.efface();
+
+	for(int tour = 0; tour != NB_TOURS; tour++) {
+		loop();
+		printf("loop %-7d octets=%4lu fronts=%3lu\n", tour, trace.nbOctets(), trace.nbFronts());
+		if(traceComplete) {
+			trace.ecrit(stdout);
+		}
+		trace.efface();
+	}
+
+	return(0);
+}
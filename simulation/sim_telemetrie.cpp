@@ -0,0 +1,182 @@
+/*!
+ *   \file    sim_telemetrie.cpp
+ *   \brief   Essai de la télémétrie de l'horloge à travers un pseudo-terminal
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Le pseudo-terminal remplace le port série USB du Leonardo : 
+ *            Telemetrie écrit côté maître, decode_telemetrie lit côté esclave.
+ *            Le port modélise le tampon de l'USB CDC, vidé à chaque tour de boucle 
+ *            sauf pendant une phase où l'hôte ne lit plus.
+ *            Du texte parasite et un paquet corrompu sont glissés dans le flux.
+ *            Code retour 1 si le bilan du décodeur ne correspond pas aux paquets écrits.
+ *
+ *            sim_telemetrie [decode_telemetrie]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <Arduino.h>
+#include "Telemetrie.h"
+
+/**
+ *   \brief   Taille du tampon d'émission de l'USB CDC du Leonardo
+ */ 
+#define TAMPON_USB 64
+
+/**
+ *   \brief   Durée d'un tour de boucle simulé en ms
+ */ 
+#define DUREE_TOUR 50
+
+/**
+ *   \brief   Délai sans octet après lequel le décodeur s'arrête, en ms
+ */ 
+#define DELAI_DECODEUR 500
+
+/**
+ *   \brief   Port série USB simulé sur le maître du pseudo-terminal
+ */ 
+class PortUsb : public Print {
+	public:
+		PortUsb(int pFd) : fd(pFd), libre(TAMPON_USB), paquets(0) {}
+		
+		size_t write(uint8_t pOctet) {
+			return(write(&pOctet, 1));
+		}
+		size_t write(const uint8_t *pOctets, size_t pTaille) {
+			if(pTaille > libre) {
+				pTaille = libre;
+			}
+			libre -= pTaille;
+			paquets += pTaille / TELEMETRIE_TAILLE;
+			return(::write(fd, pOctets, pTaille) < 0 ? 0 : pTaille);
+		}
+		int availableForWrite(void) {
+			return(libre);
+		}
+		// L'hôte a lu le tampon
+		void vide(void) {
+			libre = TAMPON_USB;
+		}
+		
+		int fd;
+		size_t libre;
+		unsigned long paquets;
+};
+
+/**
+ * \brief Un tour de boucle : le temps avance, les paquets en attente partent si le port le permet
+ *
+ * \param pTelemetrie la télémétrie
+ * \param pPort le port
+ * \param pHoteLit false si l'hôte ne lit plus
+ */
+static void tour(Telemetrie &pTelemetrie, PortUsb &pPort, bool pHoteLit)
+{
+	delay(DUREE_TOUR);
+	if(pHoteLit) {
+		pPort.vide();
+	}
+	pTelemetrie.envoie();
+}
+
+int main(int argc, char *argv[])
+{
+	const char *decodeur = argc > 1 ? argv[1] : "build/decode_telemetrie";
+	
+	int maitre = posix_openpt(O_RDWR | O_NOCTTY);
+	if(maitre < 0 || grantpt(maitre) != 0 || unlockpt(maitre) != 0) {
+		perror("posix_openpt");
+		return(1);
+	}
+	char esclave[64];
+	strncpy(esclave, ptsname(maitre), sizeof(esclave) - 1);
+	esclave[sizeof(esclave) - 1] = 0;
+	// Mode brut avant le premier octet, l'esclave reste ouvert jusqu'à la fin
+	int fdEsclave = open(esclave, O_RDWR | O_NOCTTY);
+	struct termios mode;
+	tcgetattr(fdEsclave, &mode);
+	cfmakeraw(&mode);
+	tcsetattr(fdEsclave, TCSANOW, &mode);
+	
+	int tube[2];
+	if(pipe(tube) != 0) {
+		perror("pipe");
+		return(1);
+	}
+	pid_t fils = fork();
+	if(fils == 0) {
+		char delai[16];
+		snprintf(delai, sizeof(delai), "%d", DELAI_DECODEUR);
+		dup2(tube[1], STDOUT_FILENO);
+		close(tube[0]);
+		execl(decodeur, decodeur, "-t", delai, esclave, (char *)NULL);
+		perror(decodeur);
+		_exit(2);
+	}
+	close(tube[1]);
+	
+	PortUsb port(maitre);
+	Telemetrie telemetrie(port);
+	unsigned long emis = 0;
+	
+	// Fonctionnement normal : une mesure par tour, changement de mode et d'intensité, durées du bilan
+	for(uint8_t indice = 0; indice != 40; indice++) {
+		telemetrie.mesure(indice % 4, indice != 7, 101325 + indice * 3, 2);
+		emis++;
+		if(indice % 10 == 0) {
+			telemetrie.mode(indice / 10, true);
+			telemetrie.luminosite(12 * indice, indice / 4);
+			telemetrie.duree(indice / 10, 60000UL * indice);
+			telemetrie.latence(1100 + indice, 8);
+			emis += 4;
+		}
+		tour(telemetrie, port, true);
+	}
+	
+	// Texte parasite et paquet corrompu
+	const char texte[] = "reset\r\n";
+	write(maitre, texte, sizeof(texte) - 1);
+	uint8_t corrompu[TELEMETRIE_TAILLE] = {TELEMETRIE_SYNCHRO_1, TELEMETRIE_SYNCHRO_2, TELEMETRIE_MESURE, 40};
+	write(maitre, corrompu, sizeof(corrompu));
+	
+	// L'hôte ne lit plus : tampon USB plein, puis file pleine, les paquets suivants sont perdus
+	for(uint8_t indice = 0; indice != 20; indice++) {
+		telemetrie.boucle(400 + indice, 1000);
+		emis++;
+		tour(telemetrie, port, false);
+	}
+	
+	// L'hôte relit, la file se vide
+	for(uint8_t indice = 0; indice != 10; indice++) {
+		telemetrie.energie(1000 + indice, 1250);
+		emis++;
+		tour(telemetrie, port, true);
+	}
+	
+	// Tout le flux est passé par le pseudo-terminal avant la fin du décodeur
+	FILE *sortie = fdopen(tube[0], "r");
+	char ligne[256];
+	unsigned long paquets = 0, erreurs = 0, pertes = 0, ignores = 0;
+	while(fgets(ligne, sizeof(ligne), sortie) != NULL) {
+		fputs(ligne, stdout);
+		sscanf(ligne, "{\"paquets\":%lu,\"erreurs_crc\":%lu,\"pertes\":%lu,\"octets_ignores\":%lu}", &paquets, &erreurs, &pertes, &ignores);
+	}
+	int statut;
+	waitpid(fils, &statut, 0);
+	close(fdEsclave);
+	close(maitre);
+	
+	bool ok = WIFEXITED(statut) && WEXITSTATUS(statut) == 0
+	       && paquets == port.paquets && pertes == emis - port.paquets
+	       && erreurs == 1 && ignores == sizeof(texte) - 1 + sizeof(corrompu);
+	printf("{\"emis\":%lu,\"ecrits\":%lu,\"perdus\":%lu,\"ok\":%s}\n", emis, port.paquets, emis - port.paquets, ok ? "true" : "false");
+	return(ok ? 0 : 1);
+}
@@ -0,0 +1,114 @@
+/*!
+ *   \file    Arduino.cpp
+ *   \brief   Bouchons du coeur Arduino et du SPI pour la simulation sur PC
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "../Trace.h"
+
+/**
+ *   \brief   Nombre de broches simulées
+ */ 
+#define NB_BROCHES 32
+
+SPIClass SPI;
+
+// Etat des broches
+static uint8_t modes[NB_BROCHES];
+static uint8_t niveaux[NB_BROCHES];
+
+// Temps simulé en microsecondes, n'avance qu'avec delay()
+static unsigned long temps = 0;
+
+void pinMode(uint8_t pBroche, uint8_t pMode)
+{
+	modes[pBroche % NB_BROCHES] = pMode;
+	if(pMode == INPUT_PULLUP) {
+		niveaux[pBroche % NB_BROCHES] = HIGH;
+	}
+}
+
+/**
+ * \brief Seuls les changements de niveau d'une sortie vont dans la trace
+ */
+void digitalWrite(uint8_t pBroche, uint8_t pNiveau)
+{
+	uint8_t broche = pBroche % NB_BROCHES;
+	pNiveau = pNiveau ? HIGH : LOW;
+	if(modes[broche] == OUTPUT && niveaux[broche] != pNiveau) {
+		trace.front(pBroche, pNiveau);
+	}
+	niveaux[broche] = pNiveau;
+}
+
+int digitalRead(uint8_t pBroche)
+{
+	return(niveaux[pBroche % NB_BROCHES]);
+}
+
+unsigned long millis(void)
+{
+	return(temps / 1000);
+}
+
+unsigned long micros(void)
+{
+	return(temps);
+}
+
+void delay(unsigned long pMs)
+{
+	temps += pMs * 1000;
+}
+
+void delayMicroseconds(unsigned int pUs)
+{
+	temps += pUs;
+}
+
+void lectureFlash(void)
+{
+	trace.lecture();
+}
+
+void SPIClass::begin(void)
+{
+}
+
+void SPIClass::end(void)
+{
+}
+
+void SPIClass::setBitOrder(uint8_t)
+{
+}
+
+void SPIClass::beginTransaction(SPISettings pSettings)
+{
+	trace.transaction(pSettings.frequence);
+}
+
+void SPIClass::endTransaction(void)
+{
+}
+
+/**
+ * \brief Les MAX7219 ne répondent pas, MISO est lu à 0
+ */
+uint8_t SPIClass::transfer(uint8_t pOctet)
+{
+	trace.octet(pOctet);
+	return(0x00);
+}
+
+void SPIClass::transfer(void *pTampon, size_t pTaille)
+{
+	uint8_t *octet = (uint8_t *)pTampon;
+	for(size_t indice = 0; indice != pTaille; indice++) {
+		octet[indice] = transfer(octet[indice]);
+	}
+}
@@ -0,0 +1,29 @@
+/*!
+ *   \file    Print.h
+ *   \brief   Bouchon de la classe Print du coeur Arduino, écriture d'octets seulement
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef PRINT_H_
+#define PRINT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+class Print {
+	public:
+		virtual size_t write(uint8_t) = 0;
+		virtual size_t write(const uint8_t *pOctets, size_t pTaille) {
+			size_t ecrits = 0;
+			while(pTaille-- && write(*pOctets++)) {
+				ecrits++;
+			}
+			return(ecrits);
+		}
+		virtual int availableForWrite(void) { return(0); }
+		virtual ~Print(void) {}
+};
+
+#endif
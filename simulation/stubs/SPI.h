@@ -0,0 +1,42 @@
+/*!
+ *   \file    SPI.h
+ *   \brief   Bouchon de la librairie SPI, les octets sont enregistrés dans la trace
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef SPI_H_
+#define SPI_H_
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+class SPISettings {
+	public:
+		SPISettings(void) : frequence(4000000), ordre(MSBFIRST), mode(SPI_MODE0) {}
+		SPISettings(uint32_t pFrequence, uint8_t pOrdre, uint8_t pMode) : frequence(pFrequence), ordre(pOrdre), mode(pMode) {}
+		
+		uint32_t frequence;
+		uint8_t ordre;
+		uint8_t mode;
+};
+
+class SPIClass {
+	public:
+		void begin(void);
+		void end(void);
+		void setBitOrder(uint8_t);
+		void beginTransaction(SPISettings);
+		void endTransaction(void);
+		uint8_t transfer(uint8_t);
+		void transfer(void *, size_t);
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,24 @@
+/*!
+ *   \file    TimeLib.h
+ *   \brief   Bouchon de la librairie Time, seulement la structure date et heure
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef TIMELIB_H_
+#define TIMELIB_H_
+
+#include <stdint.h>
+
+typedef struct { 
+	uint8_t Second; 
+	uint8_t Minute; 
+	uint8_t Hour; 
+	uint8_t Wday;
+	uint8_t Day;
+	uint8_t Month; 
+	uint8_t Year;
+} tmElements_t;
+
+#endif
@@ -0,0 +1,30 @@
+/*!
+ *   \file    Wire.h
+ *   \brief   Bouchon de la librairie Wire (I2C)
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ *
+ *   \details Seulement déclarée : le programme de simulation définit Wire
+ *            et ses méthodes, qui modélisent le périphérique essayé.
+ */
+
+#ifndef WIRE_H_
+#define WIRE_H_
+
+#include <Arduino.h>
+
+class TwoWire {
+	public:
+		void begin(void);
+		void beginTransmission(uint8_t);
+		size_t write(uint8_t);
+		uint8_t endTransmission(void);
+		uint8_t requestFrom(uint8_t, uint8_t);
+		int available(void);
+		int read(void);
+};
+
+extern TwoWire Wire;
+
+#endif
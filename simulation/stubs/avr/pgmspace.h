@@ -0,0 +1,25 @@
+/*!
+ *   \file    pgmspace.h
+ *   \brief   Bouchon de avr/pgmspace.h, la flash est une mémoire ordinaire sur PC
+ *   \author  Totof (raspberry.pi123@orange.fr)
+ *   \version 1.0
+ *   \date    17/10/2026
+ */
+ 
+#ifndef PGMSPACE_H_
+#define PGMSPACE_H_
+
+#include <stdint.h>
+
+#define PROGMEM
+
+// Compte les lectures en flash (voir Trace::lecture)
+void lectureFlash(void);
+
+static inline uint8_t pgm_read_byte(const void *pAdresse)
+{
+	lectureFlash();
+	return(*(const uint8_t *)pAdresse);
+}
+
+#endif